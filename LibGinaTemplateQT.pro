@@ -6,12 +6,32 @@ CONFIG -= qt
 SOURCES += main.cpp \
     mygenerator.cpp \
     myprocessor.cpp \
-    myobserver.cpp
+    myobserver.cpp \
+    src/LgCompatibilityGraph.cpp \
+    src/LgFilters.cpp \
+    src/LgLeapCapture.cpp \
+    src/LgLeapGenerator.cpp \
+    src/LgNodeFactory.cpp \
+    src/LgPipelineConfig.cpp \
+    src/LgScheduler.cpp \
+    src/LgSharedStatePublisher.cpp \
+    src/LgStatistics.cpp \
+    src/LgThreadPool.cpp \
+    src/LgUdpStreamer.cpp
 
 win32:CONFIG(release, debug|release): LIBS += -L$$PWD/lib/ -lGinaWin32
 else:win32:CONFIG(debug, debug|release): LIBS += -L$$PWD/lib/ -lGinaWin32
 else:unix: LIBS += -L$$PWD/lib/ -lGinaUnix
 
+unix: LIBS += -lpthread -ldl -lrt
+unix: QMAKE_LFLAGS += -rdynamic
+
+# Leap Motion support (needs the Leap Motion SDK) : qmake CONFIG+=leap
+leap {
+    DEFINES += LG_WITH_LEAP
+    LIBS += -lLeap
+}
+
 INCLUDEPATH += $$PWD/include
 DEPENDPATH += $$PWD/include
 
@@ -25,22 +45,38 @@ else:unix: PRE_TARGETDEPS += $$PWD/lib/libGinaUnix.a
 HEADERS += \
     Leap.h \
     LeapMath.h \
+    LgCompatibilityGraph.h \
     LgData.h \
     LgDataTemplate.h \
     LgEnvironment.h \
+    LgFilters.h \
     LgFunctions.h \
     LgGenerator.h \
+    LgGroupSlotMap.h \
     LgGroupTemplate.h \
+    LgHistoricRequirement.h \
     LgHistoricTemplate.h \
+    LgInterpolation.h \
+    LgLeapCapture.h \
+    LgLeapGenerator.h \
+    LgLeapMath.h \
     LgMetaData.h \
     LgNode.h \
     LgNodeFactory.h \
     LgObserver.h \
+    LgPipelineConfig.h \
     LgPoint2D.h \
     LgPoint3D.h \
     LgProcessor.h \
+    LgScheduler.h \
+    LgSharedState.h \
+    LgSharedStatePublisher.h \
+    LgStaticPipeline.h \
+    LgStatistics.h \
     LgSwitch.h \
+    LgThreadPool.h \
     LgTimer.h \
+    LgUdpStreamer.h \
     mygenerator.h \
     myprocessor.h \
     myobserver.h
@@ -0,0 +1,87 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "LgFilters.h"
+
+using namespace lg;
+
+// Time a filter on a Group of the given number of joints, all the joints receiving a new value at each update
+static double benchmark(FilterProcessor* filter,size_t jointNumber,int updateNumber)
+{
+    PointBatch3D batch;
+    for(size_t i = 0;i < jointNumber;i++)
+    {
+        char id[32];
+        snprintf(id,sizeof(id),"joint%03d",(int)i);
+        batch.ids.push_back(id);
+    }
+    batch.x.resize(jointNumber);
+    batch.y.resize(jointNumber);
+    batch.z.resize(jointNumber);
+    batch.timestamps.resize(jointNumber);
+    batch.filtered.resize(jointNumber);
+
+    vector<float> samples(64*3);
+    for(int u = 0;u < 64;u++)
+    {
+        samples[u*3] = sinf(0.1f*u);
+        samples[u*3 + 1] = cosf(0.2f*u);
+        samples[u*3 + 2] = 0.01f*u;
+    }
+
+    filter->start();
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    for(int u = 0;u < updateNumber;u++)
+    {
+        // New values every 5 ms (200 Hz, as a Leap Motion), on a trajectory computed before
+        const float* sample = &samples[(u % 64)*3];
+        for(size_t i = 0;i < jointNumber;i++)
+        {
+            batch.x[i] = sample[0] + i;
+            batch.y[i] = sample[1];
+            batch.z[i] = sample[2];
+            batch.timestamps[i] = 5*u;
+        }
+        filter->processBatch(batch,"benchmark");
+    }
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+    filter->stop();
+
+    // Nanoseconds by joint and by update
+    return chrono::duration<double,nano>(end - begin).count()/((double)jointNumber*updateNumber);
+}
+
+int main(int argc,char* argv[])
+{
+    int updateNumber = (argc > 1) ? atoi(argv[1]) : 20000;
+    if(updateNumber <= 0) updateNumber = 20000;
+
+    set<string> types;
+    types.insert(LG_ORIENTEDPOINT3D_HEAD);
+    OneEuroFilterProcessor oneEuro("oneEuro",types,1.0f,0.5f);
+    KalmanFilterProcessor kalman("kalman",types);
+    MovingAverageProcessor movingAverage("movingAverage",types,5);
+    SavitzkyGolayProcessor savitzkyGolay("savitzkyGolay",types,7,2);
+    FilterProcessor* filters[] = {&oneEuro,&kalman,&movingAverage,&savitzkyGolay};
+
+    // One joint, one hand of a Leap Motion, two hands, a full body and more
+    size_t jointNumbers[] = {1,22,44,100,1000};
+
+    printf("Filter throughput (%d updates, ns by joint and by update / millions of joints by second)\n",updateNumber);
+    printf("%-16s","joints");
+    for(size_t j = 0;j < sizeof(jointNumbers)/sizeof(jointNumbers[0]);j++) printf("%18d",(int)jointNumbers[j]);
+    printf("\n");
+    for(size_t f = 0;f < sizeof(filters)/sizeof(filters[0]);f++)
+    {
+        printf("%-16s",filters[f]->getName().c_str());
+        for(size_t j = 0;j < sizeof(jointNumbers)/sizeof(jointNumbers[0]);j++)
+        {
+            double duration = benchmark(filters[f],jointNumbers[j],updateNumber);
+            printf("%9.1f /%7.1f",duration,1000.0/duration);
+        }
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,22 @@
+# Throughput of the filtering Processors by joint : qmake && make && ./filterbenchmark [updates]
+TEMPLATE = app
+CONFIG += console c++11 release
+CONFIG -= app_bundle
+CONFIG -= qt
+
+SOURCES += filterbenchmark.cpp \
+    ../src/LgCompatibilityGraph.cpp \
+    ../src/LgFilters.cpp \
+    ../src/LgNodeFactory.cpp \
+    ../src/LgScheduler.cpp \
+    ../src/LgStatistics.cpp \
+    ../src/LgThreadPool.cpp
+
+win32:CONFIG(release, debug|release): LIBS += -L$$PWD/../lib/ -lGinaWin32
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$PWD/../lib/ -lGinaWin32
+else:unix: LIBS += -L$$PWD/../lib/ -lGinaUnix
+
+unix: LIBS += -lpthread -ldl -lrt
+
+INCLUDEPATH += $$PWD/../include
+DEPENDPATH += $$PWD/../include
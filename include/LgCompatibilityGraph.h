@@ -0,0 +1,209 @@
+#pragma once
+
+/*!
+ * \file LgCompatibilityGraph.h
+ * \brief File containing the CompatibilityGraph class, an incrementally maintained graph of the data types exchanged by Nodes.
+ * \version 0.2
+ * \date 19 october 2026
+ */
+
+#ifndef LGCOMPATIBILITYGRAPH_H_
+#define LGCOMPATIBILITYGRAPH_H_
+
+#include <map>
+#include <set>
+#include <string>
+
+#include "LgNode.h"
+
+using namespace std;
+
+/*!
+ * \namespace lg
+ * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
+*/
+namespace lg
+{
+	/*!
+	 * \class CompatibilityGraph
+	 * \brief Graph linking the Nodes producing a type to the Nodes needing or consuming it, with the rules of Environment::checkCompatibility.
+	 * The Nodes are updated by increasing priorities : a type needed or consumed by a Node must be produced by a Node of a lower priority,
+	 * and not consumed since by a Node which does not produce it again (a Node consumes its inputs before producing its outputs, so an in place
+	 * transform consuming and producing a type keeps it available). A Node producing a type it also needs is not its own producer.
+	 * The graph is updated node by node : registering or unregistering a Node only visits the Nodes reading the types it declares,
+	 * between its priority and the next Node producing or consuming each type, so checking the compatibility after a runtime change does not
+	 * walk the whole set of registered Nodes.
+	 * As the outputs of a Node only feed Nodes of higher priorities, the Nodes cannot feed each other. Cycles of types (a Node needing a type
+	 * produced from its own outputs, whatever the priorities) are only searched when enabled (see enableCycleRejection), and Nodes transforming
+	 * a type in place are not linked to each other by this type : a chain of in place filters is not reported as a cycle.
+	*/
+	class CompatibilityGraph
+	{
+	private:
+		/*!
+		 * \brief Types declared by a Node when it has been added to the graph
+		 */
+		struct Vertex
+		{
+			//! Priority of the Node
+			int priority;
+
+			//! Types needed in input
+			set<string> need;
+
+			//! Types consumed in input
+			set<string> consume;
+
+			//! Types produced in output
+			set<string> produce;
+
+			// Check if the Node needs or consumes the given type and produces it
+			bool isInPlace(const string& type) const {return (produce.count(type) && (need.count(type) || consume.count(type)));}
+		};
+
+		//! Declared types of the added Nodes, stored by their unique names.
+		map<string, Vertex> _vertices;
+
+		//! Names of the added Nodes, stored by their priorities.
+		map<int, string> _priorities;
+
+		//! Names of the Nodes producing each type.
+		map<string, set<string> > _producers;
+
+		//! Names of the Nodes needing or consuming each type, stored by their priorities.
+		map<string, map<int, string> > _readers;
+
+		//! Names of the Nodes producing or consuming each type (the Nodes changing its availability), stored by their priorities.
+		map<string, map<int, string> > _writers;
+
+		//! Types needed or consumed by a Node that no Node of a lower priority makes available, stored by Node names.
+		map<string, set<string> > _missing;
+
+		//! Names of the Nodes which are part of a cycle.
+		set<string> _cyclic;
+
+		//! Store whether the cycles are searched and make the graph incompatible.
+		bool _cycleRejection;
+
+		// Mark a type as missing for a Node, or clear it
+		void setMissing(const string& nodeName,const string& type,bool missing);
+
+		// Name of the Node whose output of a type is available just before the given priority, empty if the type is not available
+		string getFeeder(const string& type,int priority) const;
+
+		// Check again the Nodes reading a type from the given priority up to the next Node producing or consuming it
+		void refreshReaders(const string& type,int priority);
+
+		// Get the Nodes needing or consuming a type produced by a Node, whatever their priorities (but the in place transforms of this type)
+		set<string> getTypeSuccessors(const string& uniqueName) const;
+
+		// Search a path from the successors of a Node back to itself, and mark the Nodes of this path as cyclic
+		bool findCycle(const string& nodeName);
+
+	public:
+		/*!
+		 * \brief Constructor
+		 */
+		CompatibilityGraph(void) : _cycleRejection(false) {}
+
+		/*!
+		 * \brief Destructor
+		 */
+		~CompatibilityGraph(void) {}
+
+		/*!
+		 * \brief Add a Node to the graph
+		 * Only the Nodes reading the types declared by the Node (need, consume and produce) after its priority are visited.
+		 * \param[in] uniqueName : the unique name of the Node in its Environment
+		 * \param[in] node : the Node to add
+		 * \param[in] priority : the priority of the Node in its Environment
+		 * \return true if success, false if a Node with the same name or the same priority is already in the graph
+		 */
+		bool addNode(const string& uniqueName,const Node* node,int priority);
+
+		/*!
+		 * \brief Remove a Node from the graph
+		 * Only the Nodes reading the types declared by the Node after its priority are visited (and the Nodes previously found in a cycle).
+		 * \param[in] uniqueName : the unique name of the Node to remove
+		 * \return true if success, false if the Node is not in the graph
+		 */
+		bool removeNode(const string& uniqueName);
+
+		/*!
+		 * \brief Check if a Node is in the graph
+		 * \param[in] uniqueName : the unique name of the Node
+		 * \return true if the Node has been added
+		 */
+		inline bool hasNode(const string& uniqueName) const {return (_vertices.count(uniqueName) > 0);}
+
+		/*!
+		 * \brief Check if a Node consumes a type (instead of only needing it)
+		 * \param[in] uniqueName : the unique name of the Node
+		 * \param[in] type : the type
+		 * \return true if the Node is in the graph and consumes the type
+		 */
+		bool isConsumed(const string& uniqueName,const string& type) const;
+
+		/*!
+		 * \brief Check if every Node has a producer of a lower priority for the types it needs, and if there are no cycles when they are rejected (O(1))
+		 * \return true if the graph is compatible
+		 */
+		inline bool isCompatible() const {return (_missing.empty() && _cyclic.empty());}
+
+		/*!
+		 * \brief Get the types needed or consumed by Nodes which are not available at their priority
+		 * \return Map of Node names and their missing types
+		 */
+		inline const map<string, set<string> >& getMissingProducers() const {return _missing;}
+
+		/*!
+		 * \brief Get the state of the cycle rejection option.
+		 * \return Value of the option.
+		 */
+		inline bool cycleRejectionEnabled() const {return _cycleRejection;}
+
+		/*!
+		 * \brief Enable/disable the cycle rejection option (disabled by default).
+		 * When enabled, the Nodes needing a type produced from their own outputs (whatever the priorities) are searched at each change,
+		 * and make the graph incompatible. Enabling it searches the cycles among all the Nodes already added.
+		 * \param[in] enabled : the new state of the option
+		 */
+		void enableCycleRejection(bool enabled);
+
+		/*!
+		 * \brief Get the Nodes which are part of a cycle (always empty if the cycles are not rejected)
+		 * \return Set of Node names
+		 */
+		inline const set<string>& getCyclicNodes() const {return _cyclic;}
+
+		/*!
+		 * \brief Get the Nodes producing a type
+		 * \param[in] type : the produced type
+		 * \return Set of Node names (can be empty)
+		 */
+		set<string> getProducers(const string& type) const;
+
+		/*!
+		 * \brief Get the Nodes needing or consuming a type
+		 * \param[in] type : the needed type
+		 * \return Set of Node names (can be empty)
+		 */
+		set<string> getConsumers(const string& type) const;
+
+		/*!
+		 * \brief Get the Nodes directly fed by a Node
+		 * These are the Nodes of higher priorities needing or consuming one of its produced types, up to the first one consuming it without
+		 * producing it again.
+		 * \param[in] uniqueName : the unique name of the Node
+		 * \return Set of Node names (can be empty)
+		 */
+		set<string> getSuccessors(const string& uniqueName) const;
+
+		/*!
+		 * \brief Remove every Node from the graph
+		 */
+		void clear();
+	};
+}
+
+#endif /* LGCOMPATIBILITYGRAPH_H_ */
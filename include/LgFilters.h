@@ -0,0 +1,400 @@
+#pragma once
+
+/*!
+ * \file LgFilters.h
+ * \brief File containing filtering Processors (One Euro, Kalman, moving average, Savitzky-Golay) working on all the points of a Group at once.
+ * \version 0.2
+ * \date 19 october 2026
+ */
+
+#ifndef LGFILTERS_H_
+#define LGFILTERS_H_
+
+/*!
+* \brief Suffix added to the type of a filtered point for naming the type of its filtered values
+*/
+#define LG_FILTER_OUTPUT_SUFFIX "_PROCESSED"
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "LgProcessor.h"
+
+using namespace std;
+
+/*!
+ * \namespace lg
+ * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
+*/
+namespace lg
+{
+	/*!
+	 * \brief Last values of the filtered points of a Group, stored as separate arrays of coordinates.
+	 * Filters run one loop per coordinate over contiguous arrays, which the compiler can vectorize.
+	*/
+	struct PointBatch3D
+	{
+		//! Ids of the HistoricTemplate in the Group
+		vector<string> ids;
+
+		//! Types of the HistoricTemplate
+		vector<string> types;
+
+		//! The HistoricTemplate (for rewriting their last values in place)
+		vector<HOrientedPoint3D*> historics;
+
+		//! X coordinates of the positions (filtered in place)
+		vector<float> x;
+
+		//! Y coordinates of the positions (filtered in place)
+		vector<float> y;
+
+		//! Z coordinates of the positions (filtered in place)
+		vector<float> z;
+
+		//! Orientations (not filtered)
+		vector<Point3D> orientations;
+
+		//! Confidences (not filtered)
+		vector<float> confidences;
+
+		//! Intensities (not filtered)
+		vector<float> intensities;
+
+		//! Timestamps of the last values
+		vector<int> timestamps;
+
+		//! Information whether each point has been filtered (not set for the points without new value)
+		vector<char> filtered;
+
+		/*!
+		 * \brief Get the number of points
+		 * \return Number of points in the batch
+		 */
+		inline size_t size() const {return ids.size();}
+
+		/*!
+		 * \brief Remove all the points
+		 */
+		void clear();
+
+		/*!
+		 * \brief Add the last value of an HistoricTemplate
+		 * \param[in] historic : the HistoricTemplate (must not be empty)
+		 */
+		void add(HOrientedPoint3D* historic);
+
+		/*!
+		 * \brief Get a coordinate array
+		 * \param[in] coordinate : 0 for x, 1 for y, 2 for z
+		 * \return Pointer to the first value of the coordinate
+		 */
+		inline float* coordinate(int coordinate) {return (coordinate == 0) ? &x[0] : ((coordinate == 1) ? &y[0] : &z[0]);}
+	};
+
+	/*!
+	 * \brief State of a filter for the points of a Group (or for some of them, given together to the filter)
+	*/
+	struct FilterState
+	{
+		//! Ids of the points, in the order of the batch
+		vector<string> ids;
+
+		//! Values of the filter : for each value of the filter, 3 arrays (x, y, z) of one value by point
+		vector<float> values;
+
+		//! Timestamp of the last filtered value of each point
+		vector<int> timestamps;
+
+		//! Number of values filtered of each point since it appeared
+		vector<int> counts;
+
+		//! Number of values filtered of the points given to the filter (the same for all of them)
+		int count;
+
+		FilterState() : count(0) {}
+
+		/*!
+		 * \brief Set the points of the state, keeping the values of the points already there (the new ones start from 0)
+		 * \param[in] pointIDs : the ids of the points, sorted
+		 * \param[in] size : the number of values of the filter
+		 */
+		void setPoints(const vector<string>& pointIDs,int size);
+
+		/*!
+		 * \brief Get an array of values of the filter
+		 * \param[in] value : index of the value of the filter
+		 * \param[in] coordinate : 0 for x, 1 for y, 2 for z
+		 * \return Pointer to the value of the first point
+		 */
+		inline float* get(int value,int coordinate) {return &values[(value*3 + coordinate)*ids.size()];}
+	};
+
+	/*!
+	 * \class FilterProcessor
+	 * \brief Mother class of the filtering Processors.
+	 * At each update, the last values of the filtered types of each processed Group are gathered in a PointBatch3D, filtered all together,
+	 * then written in the Group with the type suffixed by LG_FILTER_OUTPUT_SUFFIX (LG_ORIENTEDPOINT3D_RIGHT_HAND_PROCESSED ...).
+	 * With processInPlace(true), the filtered values replace the last values of the filtered types instead (their MetaData are not kept) :
+	 * the types are consumed and produced, and no *_PROCESSED historic is created.
+	 * The types can be restrained with onlyProcessPointType/ignorePointType and the Groups with onlyProcessGroupIDs/ignoreGroupIDs...
+	 * Timestamps are expected in milliseconds (as given by the Environment or the Scheduler).
+	 * The Environment gives all the Groups at each update : the states of the Groups which are no longer given are removed.
+	 * The Scheduler may only give some of them (see Scheduler::enableDirtyTracking and Scheduler::setFreshnessBudget) :
+	 * it removes the states itself when the Groups are removed (see removeGroupState).
+	*/
+	class FilterProcessor : public Processor
+	{
+	private:
+		//! State of the filter for each Group
+		map<string, FilterState> _states;
+
+		//! Batch reused at each update
+		PointBatch3D _batch;
+
+		//! Points given together to the filter when the points of a Group are not at the same step (reused at each update)
+		PointBatch3D _subBatch;
+		FilterState _subState;
+		vector<size_t> _subPoints;
+
+		//! Information whether the filtered values replace the last values
+		bool _inPlace;
+
+	protected:
+		//! Types of the filtered points
+		set<string> _types;
+
+		/*!
+		 * \brief Get the number of values stored by the filter for each coordinate of each point
+		 * \return Number of values of the state
+		 */
+		virtual int getStateSize() const = 0;
+
+		/*!
+		 * \brief Filter the points of a Group
+		 * \param[in,out] batch : the last values of the points, replaced by the filtered values
+		 * \param[in,out] state : the state of the filter for these points (values set to 0 and count to 0 for new points)
+		 * \param[in] dt : time since the last filtered values, in seconds (0 at the first values), the same for all the points
+		 */
+		virtual void filterBatch(PointBatch3D& batch,FilterState& state,float dt) = 0;
+
+		/*!
+		 * \brief Copy the restrictions of Groups and types to another FilterProcessor (for implementing clone)
+		 * \param[in] clone : the FilterProcessor receiving the restrictions
+		 * \return The clone
+		 */
+		Node* copyRestrictions(FilterProcessor* clone) const;
+
+	private:
+		// Filter some points of a batch (with a new value and at the same step) with their values of the state
+		void filterPoints(PointBatch3D& batch,FilterState& state,const vector<size_t>& points);
+
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param[in] name : a name for the instance of this Node
+		 * \param[in] types : the types of points to filter
+		 */
+		FilterProcessor(string name,const set<string>& types) : Processor(name),_inPlace(false),_types(types) {}
+
+		/*!
+		 * \brief Destructor
+		 */
+		virtual ~FilterProcessor(void) {}
+
+		/*!
+		 * \brief Set whether the filtered values replace the last values of the filtered types (must be set before registering the Processor)
+		 * \param[in] inPlace : true for rewriting the filtered types, false for producing the types suffixed by LG_FILTER_OUTPUT_SUFFIX (default)
+		 */
+		inline void processInPlace(bool inPlace) {_inPlace = inPlace;}
+
+		/*!
+		 * \brief Check if another filter can run in the same pass right after this one
+		 * Both must filter in place the same types of the same Groups.
+		 * \param[in] next : the filter running after this one
+		 * \return true if the two filters can be fused
+		 */
+		bool canFuseWith(const FilterProcessor* next) const;
+
+		/*!
+		 * \brief Filter the points of a Group with the state of this filter (the values are not written in the Group)
+		 * Each point is filtered with its own state : the points whose last value has already been filtered (same timestamp) are left as is,
+		 * and the points appearing in the Group start from a new state without resetting the other ones.
+		 * \param[in,out] batch : the last values of the points (sorted by id), replaced by the filtered values
+		 * \param[in] groupID : the id of the Group of the points
+		 * \return true if some values have been filtered, false if all of them have already been filtered
+		 */
+		bool processBatch(PointBatch3D& batch,const string& groupID);
+
+		/*!
+		 * \brief Forget the state of a Group (called by the Scheduler when the Group is removed)
+		 * \param[in] groupID : the id of the removed Group
+		 */
+		inline void removeGroupState(const string& groupID) {_states.erase(groupID);}
+
+		/*!
+		 * \brief Run a chain of filters in a single pass
+		 * The points of each Group are gathered once (with the restrictions of the first filter), go through all the filters in turn,
+		 * then are written once. The filters must be fusable (see canFuseWith), a single filter is a chain of one.
+		 * \param[in] chain : the filters, in their order of update
+		 * \param[in] groups3D : Groups of HOrientedPoint3D
+		 * \return true if success
+		 */
+		static bool updateChain(const vector<FilterProcessor*>& chain,map<string,Group3D*>& groups3D);
+
+		/*!
+		 * \brief Start the filter (reset its states)
+		 * \return true
+		 */
+		virtual bool start();
+
+		/*!
+		 * \brief Stop the filter
+		 * \return true
+		 */
+		virtual bool stop();
+
+		/*!
+		 * \brief Filter the last values of the processed types of the processed Groups
+		 * \param[in] groups3D : Groups of HOrientedPoint3D
+		 * \return true if success
+		 */
+		virtual bool update(map<string,Group3D*>& groups3D,map<string,Group2D*>&,map<string,Group1D*>&,map<string,GroupSwitch*>&);
+
+		/*!
+		 * \brief Return the filtered types (restrained by onlyProcessPointType/ignorePointType), none in place
+		 * \return A set of type
+		 */
+		virtual set<string> need() const;
+
+		/*!
+		 * \brief Return the filtered types in place, none otherwise
+		 * \return A set of type
+		 */
+		virtual set<string> consume() const;
+
+		/*!
+		 * \brief Return the filtered types suffixed by LG_FILTER_OUTPUT_SUFFIX (the filtered types in place)
+		 * \return A set of type
+		 */
+		virtual set<string> produce() const;
+	};
+
+	/*!
+	 * \class OneEuroFilterProcessor
+	 * \brief Adaptive low-pass filter : smooth at low speed, reactive at high speed (Casiez et al., 1 Euro filter).
+	*/
+	class OneEuroFilterProcessor : public FilterProcessor
+	{
+	private:
+		float _minCutoff;
+		float _beta;
+		float _derivativeCutoff;
+
+	protected:
+		int getStateSize() const {return 2;}
+		void filterBatch(PointBatch3D& batch,FilterState& state,float dt);
+
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param[in] name : a name for the instance of this Node
+		 * \param[in] types : the types of points to filter
+		 * \param[in] minCutoff : the minimum cutoff frequency in Hz (lower = smoother at low speed)
+		 * \param[in] beta : the speed coefficient (higher = less lag at high speed)
+		 * \param[in] derivativeCutoff : the cutoff frequency of the speed in Hz
+		 */
+		OneEuroFilterProcessor(string name,const set<string>& types,float minCutoff = 1.0f,float beta = 0.0f,float derivativeCutoff = 1.0f);
+
+		Node* clone(string cloneName) const;
+	};
+
+	/*!
+	 * \class KalmanFilterProcessor
+	 * \brief Kalman filter with a constant velocity model, applied on each coordinate.
+	*/
+	class KalmanFilterProcessor : public FilterProcessor
+	{
+	private:
+		float _processNoise;
+		float _measurementNoise;
+
+	protected:
+		int getStateSize() const {return 5;}
+		void filterBatch(PointBatch3D& batch,FilterState& state,float dt);
+
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param[in] name : a name for the instance of this Node
+		 * \param[in] types : the types of points to filter
+		 * \param[in] processNoise : the variance of the acceleration (higher = more reactive)
+		 * \param[in] measurementNoise : the variance of the measured positions (higher = smoother)
+		 */
+		KalmanFilterProcessor(string name,const set<string>& types,float processNoise = 1.0f,float measurementNoise = 0.01f);
+
+		Node* clone(string cloneName) const;
+	};
+
+	/*!
+	 * \class MovingAverageProcessor
+	 * \brief Mean of the last values of each point.
+	*/
+	class MovingAverageProcessor : public FilterProcessor
+	{
+	private:
+		int _window;
+
+	protected:
+		int getStateSize() const {return _window + 1;}
+		void filterBatch(PointBatch3D& batch,FilterState& state,float dt);
+
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param[in] name : a name for the instance of this Node
+		 * \param[in] types : the types of points to filter
+		 * \param[in] window : the number of values averaged
+		 */
+		MovingAverageProcessor(string name,const set<string>& types,int window = 5);
+
+		Node* clone(string cloneName) const;
+	};
+
+	/*!
+	 * \class SavitzkyGolayProcessor
+	 * \brief Least-squares polynomial fitted on the last values of each point, evaluated at the last value (causal Savitzky-Golay filter).
+	*/
+	class SavitzkyGolayProcessor : public FilterProcessor
+	{
+	private:
+		int _window;
+		int _order;
+
+		//! Weights of the values, from the oldest to the newest
+		vector<float> _coefficients;
+
+		//! Filtered values of a coordinate, kept between the updates for not allocating them each time
+		vector<float> _filtered;
+
+	protected:
+		int getStateSize() const {return _window;}
+		void filterBatch(PointBatch3D& batch,FilterState& state,float dt);
+
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param[in] name : a name for the instance of this Node
+		 * \param[in] types : the types of points to filter
+		 * \param[in] window : the number of values fitted
+		 * \param[in] order : the order of the polynomial (lower than window)
+		 */
+		SavitzkyGolayProcessor(string name,const set<string>& types,int window = 7,int order = 2);
+
+		Node* clone(string cloneName) const;
+	};
+}
+
+#endif /* LGFILTERS_H_ */
@@ -0,0 +1,281 @@
+#pragma once
+
+/*!
+ * \file LgGroupSlotMap.h
+ * \brief File containing the GroupSlotMap class template, a dense storage of values by Group with integer handles.
+ * \version 0.2
+ * \date 19 october 2026
+ */
+
+#ifndef LGGROUPSLOTMAP_H_
+#define LGGROUPSLOTMAP_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/*!
+ * \namespace lg
+ * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
+*/
+namespace lg
+{
+	/*!
+	 * \brief Handle on a value of a GroupSlotMap
+	 * A handle stays valid until its value is removed, whatever the other insertions and removals. Once removed, the generation of its slot
+	 * changes and the handle is rejected (even if the slot is reused).
+	*/
+	struct GroupHandle
+	{
+		//! Index of the slot
+		unsigned int index;
+
+		//! Generation of the slot when the handle was given
+		unsigned int generation;
+
+		GroupHandle() : index(0),generation(0) {}
+		GroupHandle(unsigned int i,unsigned int g) : index(i),generation(g) {}
+
+		/*!
+		 * \brief Check if the handle has been given by a GroupSlotMap (it may have been removed since)
+		 * \return false for a default handle
+		 */
+		inline bool isSet() const {return (generation != 0);}
+
+		inline bool operator==(const GroupHandle& other) const {return ((index == other.index)&&(generation == other.generation));}
+		inline bool operator!=(const GroupHandle& other) const {return !(*this == other);}
+	};
+
+	/*!
+	 * \class GroupSlotMap
+	 * \brief Values stored by Group ids in a dense array, with generation-checked integer handles.
+	 * Values are contiguous : walking all of them is a linear walk of an array (see size and at), and removing a value moves the last one
+	 * in its place without invalidating the other handles. Ids are indexed in a hash map for finding handles from Group ids.
+	*/
+	template <typename T> class GroupSlotMap
+	{
+	private:
+		/*!
+		 * \brief Indirection from a handle to the dense arrays
+		 */
+		struct Slot
+		{
+			//! Position of the value in the dense arrays (or next free slot if the slot is free)
+			unsigned int position;
+
+			//! Generation of the slot, incremented at each removal (always odd when used)
+			unsigned int generation;
+		};
+
+		//! Slots, addressed by handles
+		vector<Slot> _slots;
+
+		//! First free slot (_slots.size() if there is none)
+		unsigned int _freeSlot;
+
+		//! Values, contiguous
+		vector<T> _values;
+
+		//! Group ids of the values
+		vector<string> _ids;
+
+		//! Slots of the values
+		vector<unsigned int> _slotsOfValues;
+
+		//! Handles of the Group ids
+		unordered_map<string, GroupHandle> _index;
+
+		// Position of the value of a handle in the dense arrays, -1 if the handle is invalid
+		inline int positionOf(const GroupHandle& handle) const
+		{
+			if((handle.index >= _slots.size())||(_slots[handle.index].generation != handle.generation)||((handle.generation & 1) == 0)) return -1;
+			return (int)_slots[handle.index].position;
+		}
+
+	public:
+		/*!
+		 * \brief Constructor
+		 */
+		GroupSlotMap(void) : _freeSlot(0) {}
+
+		/*!
+		 * \brief Add a value for a Group, or replace the value of the Group
+		 * \param[in] id : the id of the Group
+		 * \param[in] value : the value
+		 * \return The handle of the value (the previous one if the Group already had a value)
+		 */
+		GroupHandle insert(const string& id,const T& value)
+		{
+			typename unordered_map<string, GroupHandle>::iterator it = _index.find(id);
+			if(it != _index.end())
+			{
+				_values[_slots[it->second.index].position] = value;
+				return it->second;
+			}
+
+			// Reuse a free slot, or add one
+			unsigned int index = _freeSlot;
+			if(index == _slots.size())
+			{
+				Slot slot;
+				slot.position = 0;
+				slot.generation = 0;
+				_slots.push_back(slot);
+				_freeSlot = (unsigned int)_slots.size();
+			}
+			else _freeSlot = _slots[index].position;
+
+			Slot& slot = _slots[index];
+			slot.generation++;
+			slot.position = (unsigned int)_values.size();
+			_values.push_back(value);
+			_ids.push_back(id);
+			_slotsOfValues.push_back(index);
+
+			GroupHandle handle(index,slot.generation);
+			_index[id] = handle;
+			return handle;
+		}
+
+		/*!
+		 * \brief Get the value of a Group, adding a default value if the Group has none
+		 * \param[in] id : the id of the Group
+		 * \return The value of the Group
+		 */
+		T& operator[](const string& id)
+		{
+			typename unordered_map<string, GroupHandle>::iterator it = _index.find(id);
+			if(it != _index.end()) return _values[_slots[it->second.index].position];
+			return _values[_slots[insert(id,T()).index].position];
+		}
+
+		/*!
+		 * \brief Remove the value of a handle
+		 * The last value is moved in its place : positions (see at) change, handles do not.
+		 * \param[in] handle : the handle of the value
+		 * \return true if success, false if the handle is invalid
+		 */
+		bool erase(const GroupHandle& handle)
+		{
+			int position = positionOf(handle);
+			if(position < 0) return false;
+
+			_index.erase(_ids[position]);
+
+			// Move the last value in the removed place
+			unsigned int last = (unsigned int)_values.size() - 1;
+			if((unsigned int)position != last)
+			{
+				_values[position] = _values[last];
+				_ids[position] = _ids[last];
+				_slotsOfValues[position] = _slotsOfValues[last];
+				_slots[_slotsOfValues[position]].position = position;
+			}
+			_values.pop_back();
+			_ids.pop_back();
+			_slotsOfValues.pop_back();
+
+			// Free the slot
+			Slot& slot = _slots[handle.index];
+			slot.generation++;
+			slot.position = _freeSlot;
+			_freeSlot = handle.index;
+			return true;
+		}
+
+		/*!
+		 * \brief Remove the value of a Group
+		 * \param[in] id : the id of the Group
+		 * \return true if success, false if the Group has no value
+		 */
+		bool erase(const string& id) {return erase(find(id));}
+
+		/*!
+		 * \brief Get the handle of the value of a Group
+		 * \param[in] id : the id of the Group
+		 * \return The handle, a default (unset) handle if the Group has no value
+		 */
+		GroupHandle find(const string& id) const
+		{
+			typename unordered_map<string, GroupHandle>::const_iterator it = _index.find(id);
+			if(it == _index.end()) return GroupHandle();
+			return it->second;
+		}
+
+		/*!
+		 * \brief Check if a handle designates a value
+		 * \param[in] handle : the handle
+		 * \return true if the value has not been removed
+		 */
+		inline bool isValid(const GroupHandle& handle) const {return (positionOf(handle) >= 0);}
+
+		/*!
+		 * \brief Get the value of a handle
+		 * \param[in] handle : the handle
+		 * \return The value, NULL if the handle is invalid
+		 */
+		inline T* get(const GroupHandle& handle) {int position = positionOf(handle);return (position < 0) ? 0 : &_values[position];}
+		inline const T* get(const GroupHandle& handle) const {int position = positionOf(handle);return (position < 0) ? 0 : &_values[position];}
+
+		/*!
+		 * \brief Get the value of a Group
+		 * \param[in] id : the id of the Group
+		 * \return The value, NULL if the Group has no value
+		 */
+		inline T* get(const string& id) {return get(find(id));}
+		inline const T* get(const string& id) const {return get(find(id));}
+
+		/*!
+		 * \brief Get the number of values
+		 * \return Number of values
+		 */
+		inline size_t size() const {return _values.size();}
+
+		/*!
+		 * \brief Check if there are no values
+		 * \return true if empty
+		 */
+		inline bool empty() const {return _values.empty();}
+
+		/*!
+		 * \brief Get a value by its position in the dense array (for walking all the values)
+		 * \param[in] position : between 0 and size() - 1
+		 * \return The value
+		 */
+		inline T& at(size_t position) {return _values[position];}
+		inline const T& at(size_t position) const {return _values[position];}
+
+		/*!
+		 * \brief Get the Group id of a value by its position in the dense array
+		 * \param[in] position : between 0 and size() - 1
+		 * \return The id of the Group
+		 */
+		inline const string& idAt(size_t position) const {return _ids[position];}
+
+		/*!
+		 * \brief Get the Group id of the value of a handle
+		 * \param[in] handle : the handle
+		 * \return The id of the Group, NULL if the handle is invalid
+		 */
+		inline const string* idOf(const GroupHandle& handle) const {int position = positionOf(handle);return (position < 0) ? 0 : &_ids[position];}
+
+		/*!
+		 * \brief Get the handle of a value by its position in the dense array
+		 * \param[in] position : between 0 and size() - 1
+		 * \return The handle of the value
+		 */
+		inline GroupHandle handleAt(size_t position) const {return GroupHandle(_slotsOfValues[position],_slots[_slotsOfValues[position]].generation);}
+
+		/*!
+		 * \brief Remove all the values (all the handles become invalid)
+		 */
+		void clear()
+		{
+			while(!_values.empty()) erase(handleAt(_values.size() - 1));
+		}
+	};
+}
+
+#endif /* LGGROUPSLOTMAP_H_ */
@@ -0,0 +1,62 @@
+#pragma once
+
+/*!
+ * \file LgHistoricRequirement.h
+ * \brief File containing the HistoricRequirement class, an interface for Nodes declaring the length of historic they need.
+ * \version 0.2
+ * \date 19 october 2026
+ */
+
+#ifndef LGHISTORICREQUIREMENT_H_
+#define LGHISTORICREQUIREMENT_H_
+
+#include <map>
+#include <string>
+
+using namespace std;
+
+/*!
+ * \namespace lg
+ * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
+*/
+namespace lg
+{
+	/*!
+	 * \class HistoricRequirement
+	 * \brief Interface for Nodes needing a specific number of successive values for some types or some Groups.
+	 * A Node inheriting from this class next to Generator, Processor or Observer declares the lengths of the historics it reads.
+	 * When the Node is registered through a Scheduler, the HistoricTemplate of these types (or of these Groups) keep the maximum length
+	 * asked by the registered Nodes, the others keep the default length of the Scheduler.
+	 * For example, a swipe Observer asks for 60 values of the hand while the other joints only keep 2.
+	 * A Node can also ask for a time window (for example the last 500 ms of the hand), which does not depend on the rate of the Generator.
+	*/
+	class HistoricRequirement
+	{
+	public:
+		/*!
+		 * \brief Destructor
+		 */
+		virtual ~HistoricRequirement(void) {}
+
+		/*!
+		 * \brief Get the number of successive values needed for some types of HistoricTemplate
+		 * \return Map of lengths stored by types (empty by default)
+		 */
+		virtual map<string,int> historicLengths() const {return map<string,int>();}
+
+		/*!
+		 * \brief Get the number of successive values needed for all the HistoricTemplate of some Groups
+		 * \return Map of lengths stored by Group ids (empty by default)
+		 */
+		virtual map<string,int> groupHistoricLengths() const {return map<string,int>();}
+
+		/*!
+		 * \brief Get the time during which the values of some types of HistoricTemplate are needed
+		 * The values older than the window are removed whatever the rate of the Generator, the last value is always kept.
+		 * \return Map of windows (same unit as the timestamps) stored by types (empty by default)
+		 */
+		virtual map<string,int> historicWindows() const {return map<string,int>();}
+	};
+}
+
+#endif /* LGHISTORICREQUIREMENT_H_ */
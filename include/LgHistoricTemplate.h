@@ -13,6 +13,8 @@
 
 #include <map>
 
+#include "LgInterpolation.h"
+
 using namespace std;
 
 /*!
@@ -112,6 +114,29 @@ public:
         }
     }
 
+    /*!
+         * \brief Remove the oldest values until the historic has at most the given number of values
+         * The last value is always kept.
+         * \param[in] length : the maximum number of values to keep
+         */
+    void trimHistoric(int length){
+        if(length < 1) length = 1;
+        while((int)_historic.size() > length)
+            _historic.erase(_historic.begin());
+    }
+
+    /*!
+         * \brief Remove the values older than a given timestamp, keeping at least a given number of values
+         * Values are removed from the front, so the cost is amortized O(1) by removed value.
+         * \param[in] timestamp : the oldest timestamp to keep
+         * \param[in] minLength : the minimum number of values to keep
+         */
+    void trimHistoricBefore(int timestamp,int minLength = 1){
+        if(minLength < 1) minLength = 1;
+        while(((int)_historic.size() > minLength)&&(_historic.begin()->first < timestamp))
+            _historic.erase(_historic.begin());
+    }
+
     /*!
          * \brief Get all the historic
          * \return Map of the historic (timestamps as keys)
@@ -129,6 +154,17 @@ public:
             return 0;
     }
 
+    /*!
+         * \brief Get the time between the first and the last values of the historic
+         * \return The time span of the historic, 0 if the historic has less than two values
+         */
+    int getTimeSpan() const {
+        if(_historic.size() > 1)
+            return _historic.rbegin()->first - _historic.begin()->first;
+        else
+            return 0;
+    }
+
     /*!
          * \brief Get the last value that has been added to the historic
          * \return The last value that has been added to the historic, NULL if the histric is empty
@@ -146,6 +182,81 @@ public:
          */
     bool isEmpty() const {return (_historic.size() == 0);}
 
+    /*!
+         * \brief Get the value of the historic at a given time
+         * The two stored values around the time are found by a binary search on the timestamps (O(log n)) and interpolated.
+         * \param[in] timestamp : the wanted time
+         * \param[out] sample : the value at this time (not modified if the time is not covered)
+         * \param[in] mode : LG_INTERPOLATION_LINEAR, or LG_INTERPOLATION_SLERP for interpolating orientations along the shortest rotation
+         * \return true if the time is between the first and the last timestamps of the historic, false otherwise
+         */
+    bool sampleAt(int timestamp,T& sample,int mode = LG_INTERPOLATION_LINEAR) const {
+        typename map<int,T>::const_iterator after = _historic.lower_bound(timestamp);
+        if(after == _historic.end()) return false;
+        if(after->first == timestamp){
+            sample = after->second;
+            return true;
+        }
+        if(after == _historic.begin()) return false;
+
+        typename map<int,T>::const_iterator before = after;
+        before--;
+        sample = interpolate(before->second,after->second,(float)(timestamp - before->first)/(float)(after->first - before->first),mode);
+        return true;
+    }
+
+    /*!
+         * \brief Get the velocity of the position at a given time
+         * Computed from the two stored values around the time (the two first ones at the first timestamp), by unit of timestamp.
+         * \param[in] timestamp : the wanted time
+         * \param[out] velocity : the variation of the position at this time (not modified if it cannot be computed)
+         * \return true if the time is covered by the historic and there are at least two values, false otherwise
+         */
+    template <typename P> bool velocityAt(int timestamp,P& velocity) const {
+        if(_historic.size() < 2) return false;
+
+        typename map<int,T>::const_iterator after = _historic.lower_bound(timestamp);
+        if(after == _historic.end()) return false;
+        if(after == _historic.begin()){
+            if(after->first != timestamp) return false;
+            after++;
+        }
+
+        typename map<int,T>::const_iterator before = after;
+        before--;
+        velocity = derivative(before->second.getPosition(),after->second.getPosition(),(float)(after->first - before->first));
+        return true;
+    }
+
+    /*!
+         * \brief Get the acceleration of the position at a given time
+         * Computed from three successive stored values around the time, by unit of timestamp squared.
+         * \param[in] timestamp : the wanted time
+         * \param[out] acceleration : the variation of the velocity at this time (not modified if it cannot be computed)
+         * \return true if the time is covered by the historic and there are at least three values, false otherwise
+         */
+    template <typename P> bool accelerationAt(int timestamp,P& acceleration) const {
+        if(_historic.size() < 3) return false;
+        if((timestamp < _historic.begin()->first)||(timestamp > _historic.rbegin()->first)) return false;
+
+        // Keep one value on each side of the middle one
+        typename map<int,T>::const_iterator middle = _historic.lower_bound(timestamp);
+        if(middle == _historic.begin()) middle++;
+        typename map<int,T>::const_iterator after = middle;
+        after++;
+        if(after == _historic.end()){
+            middle--;
+            after--;
+        }
+        typename map<int,T>::const_iterator before = middle;
+        before--;
+
+        P first = derivative(before->second.getPosition(),middle->second.getPosition(),(float)(middle->first - before->first));
+        P second = derivative(middle->second.getPosition(),after->second.getPosition(),(float)(after->first - middle->first));
+        acceleration = derivative(first,second,(float)(after->first - before->first)/2.0f);
+        return true;
+    }
+
     /*!
          * \brief Indicates if the historic is valid
          * \return true if the historic is valid, false otherwise
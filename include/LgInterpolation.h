@@ -0,0 +1,146 @@
+#pragma once
+
+/*!
+ * \file LgInterpolation.h
+ * \brief File containing the functions for interpolating and differentiating data between two timestamps
+ * \version 0.2
+ * \date 19 october 2026
+ */
+
+#ifndef LGINTERPOLATION_H_
+#define LGINTERPOLATION_H_
+
+/*!
+ * \def LG_INTERPOLATION_LINEAR
+ * \brief Interpolate every value (positions and orientations) linearly.
+*/
+#define LG_INTERPOLATION_LINEAR 0
+
+/*!
+ * \def LG_INTERPOLATION_SLERP
+ * \brief Interpolate positions linearly and orientations along the shortest rotation (slerp). Orientations must be in radians.
+*/
+#define LG_INTERPOLATION_SLERP 1
+
+#include <math.h>
+
+#include "LgDataTemplate.h"
+#include "LgPoint2D.h"
+#include "LgPoint3D.h"
+#include "LgSwitch.h"
+
+/*!
+ * \namespace lg
+ * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
+*/
+namespace lg
+{
+	/*!
+	 * \brief Linear interpolation between two values
+	 * \param[in] from : value at ratio 0
+	 * \param[in] to : value at ratio 1
+	 * \param[in] ratio : position between the two values (between 0.0 and 1.0)
+	 * \return The interpolated value
+	 */
+	inline float interpolate(float from,float to,float ratio) {return from + (to - from)*ratio;}
+	inline bool interpolate(bool from,bool to,float ratio) {return (ratio < 0.5f) ? from : to;}
+	inline Point2D interpolate(const Point2D& from,const Point2D& to,float ratio) {return Point2D(interpolate(from.getX(),to.getX(),ratio),interpolate(from.getY(),to.getY(),ratio));}
+	inline Point3D interpolate(const Point3D& from,const Point3D& to,float ratio) {return Point3D(interpolate(from.getX(),to.getX(),ratio),interpolate(from.getY(),to.getY(),ratio),interpolate(from.getZ(),to.getZ(),ratio));}
+
+	/*!
+	 * \brief Interpolation of orientations along the shortest rotation
+	 * 2D orientations are angles, 3D orientations are Euler angles (rotation around X, then Y, then Z), all in radians.
+	 * \param[in] from : orientation at ratio 0
+	 * \param[in] to : orientation at ratio 1
+	 * \param[in] ratio : position between the two orientations (between 0.0 and 1.0)
+	 * \return The interpolated orientation
+	 */
+	inline float interpolateOrientation(float from,float to,float ratio)
+	{
+		float delta = to - from;
+		delta = (float)atan2(sin(delta),cos(delta));
+		return from + delta*ratio;
+	}
+	inline bool interpolateOrientation(bool from,bool to,float ratio) {return interpolate(from,to,ratio);}
+	inline Point3D interpolateOrientation(const Point3D& from,const Point3D& to,float ratio)
+	{
+		// Euler angles to quaternions (w,x,y,z)
+		double qa[4],qb[4];
+		const Point3D* angles[2] = {&from,&to};
+		double* quaternions[2] = {qa,qb};
+		for(int i = 0;i < 2;i++)
+		{
+			double cx = cos(angles[i]->getX()*0.5),sx = sin(angles[i]->getX()*0.5);
+			double cy = cos(angles[i]->getY()*0.5),sy = sin(angles[i]->getY()*0.5);
+			double cz = cos(angles[i]->getZ()*0.5),sz = sin(angles[i]->getZ()*0.5);
+			quaternions[i][0] = cx*cy*cz + sx*sy*sz;
+			quaternions[i][1] = sx*cy*cz - cx*sy*sz;
+			quaternions[i][2] = cx*sy*cz + sx*cy*sz;
+			quaternions[i][3] = cx*cy*sz - sx*sy*cz;
+		}
+
+		// Shortest path
+		double dot = qa[0]*qb[0] + qa[1]*qb[1] + qa[2]*qb[2] + qa[3]*qb[3];
+		if(dot < 0.0)
+		{
+			for(int i = 0;i < 4;i++) qb[i] = -qb[i];
+			dot = -dot;
+		}
+
+		double wa = 1.0 - ratio,wb = ratio;
+		if(dot < 0.9995)
+		{
+			double theta = acos(dot);
+			double s = sin(theta);
+			wa = sin((1.0 - ratio)*theta)/s;
+			wb = sin(ratio*theta)/s;
+		}
+
+		double q[4];
+		double norm = 0.0;
+		for(int i = 0;i < 4;i++)
+		{
+			q[i] = wa*qa[i] + wb*qb[i];
+			norm += q[i]*q[i];
+		}
+		norm = sqrt(norm);
+		for(int i = 0;i < 4;i++) q[i] /= norm;
+
+		// Quaternion back to Euler angles
+		double sinY = 2.0*(q[0]*q[2] - q[3]*q[1]);
+		if(sinY > 1.0) sinY = 1.0;
+		if(sinY < -1.0) sinY = -1.0;
+		return Point3D((float)atan2(2.0*(q[0]*q[1] + q[2]*q[3]),1.0 - 2.0*(q[1]*q[1] + q[2]*q[2])),
+			(float)asin(sinY),
+			(float)atan2(2.0*(q[0]*q[3] + q[1]*q[2]),1.0 - 2.0*(q[2]*q[2] + q[3]*q[3])));
+	}
+
+	/*!
+	 * \brief Interpolation between two data
+	 * Positions, confidences and intensities are interpolated linearly, orientations depending on the mode. MetaData are not interpolated.
+	 * \param[in] from : data at ratio 0
+	 * \param[in] to : data at ratio 1
+	 * \param[in] ratio : position between the two data (between 0.0 and 1.0)
+	 * \param[in] mode : LG_INTERPOLATION_LINEAR or LG_INTERPOLATION_SLERP
+	 * \return The interpolated data
+	 */
+	template <typename P,typename O> DataTemplate<P,O> interpolate(const DataTemplate<P,O>& from,const DataTemplate<P,O>& to,float ratio,int mode)
+	{
+		O orientation = (mode == LG_INTERPOLATION_SLERP) ? interpolateOrientation(from.getOrientation(),to.getOrientation(),ratio) : interpolate(from.getOrientation(),to.getOrientation(),ratio);
+		return DataTemplate<P,O>(interpolate(from.getPosition(),to.getPosition(),ratio),orientation,interpolate(from.getConfidence(),to.getConfidence(),ratio),interpolate(from.getIntensity(),to.getIntensity(),ratio));
+	}
+	inline Switch interpolate(const Switch& from,const Switch& to,float ratio,int /*mode*/) {return (ratio < 0.5f) ? from : to;}
+
+	/*!
+	 * \brief Variation between two values over a duration
+	 * \param[in] from : first value
+	 * \param[in] to : second value
+	 * \param[in] duration : time between the two values
+	 * \return The variation by unit of time
+	 */
+	inline float derivative(float from,float to,float duration) {return (to - from)/duration;}
+	inline Point2D derivative(const Point2D& from,const Point2D& to,float duration) {return Point2D(derivative(from.getX(),to.getX(),duration),derivative(from.getY(),to.getY(),duration));}
+	inline Point3D derivative(const Point3D& from,const Point3D& to,float duration) {return Point3D(derivative(from.getX(),to.getX(),duration),derivative(from.getY(),to.getY(),duration),derivative(from.getZ(),to.getZ(),duration));}
+}
+
+#endif /* LGINTERPOLATION_H_ */
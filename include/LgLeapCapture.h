@@ -0,0 +1,336 @@
+#pragma once
+
+/*!
+ * \file LgLeapCapture.h
+ * \brief File containing the capture files of Leap Motion frames : LeapCaptureWriter, LeapCaptureFile and the LeapReplaySource of a LeapGenerator.
+ * \version 0.2
+ * \date 19 october 2026
+ */
+
+#ifndef LGLEAPCAPTURE_H_
+#define LGLEAPCAPTURE_H_
+
+/*!
+* \brief Kind of record holding a serialized Leap::Frame (Leap::Frame::serialize, replayed only when built with LG_WITH_LEAP)
+*/
+#define LG_LEAP_CAPTURE_FRAME 0
+
+/*!
+* \brief Kind of record holding LeapHandSample (replayed without the Leap Motion SDK)
+*/
+#define LG_LEAP_CAPTURE_HANDS 1
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "LgLeapGenerator.h"
+#include "LgTimer.h"
+
+#ifdef LG_WITH_LEAP
+namespace Leap
+{
+	class Frame;
+}
+#endif
+
+using namespace std;
+
+/*!
+ * \namespace lg
+ * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
+*/
+namespace lg
+{
+	/*!
+	 * \brief Header of a record of a capture file, followed by its payload (padded to 8 bytes).
+	 * A capture file starts with the 8 bytes "LGLEAPCP", a version (uint32) and a reserved uint32, then holds the records one after the other.
+	 * Values are written in the byte order of the machine.
+	*/
+	struct LeapCaptureRecord
+	{
+		//! Number of bytes of the payload (without padding)
+		uint32_t length;
+
+		//! Kind of payload (LG_LEAP_CAPTURE_FRAME or LG_LEAP_CAPTURE_HANDS)
+		uint32_t kind;
+
+		//! Id of the frame
+		int64_t frameID;
+
+		//! Time of the frame since the beginning of the capture, in milliseconds
+		int32_t timestamp;
+
+		//! Padding (0)
+		uint32_t reserved;
+
+		/*!
+		 * \brief Get the payload following the header
+		 * \return Pointer to the first byte of the payload
+		 */
+		inline const unsigned char* getPayload() const {return reinterpret_cast<const unsigned char*>(this + 1);}
+	};
+
+	/*!
+	 * \class LeapCaptureWriter
+	 * \brief Writer of capture files.
+	*/
+	class LeapCaptureWriter
+	{
+	private:
+		//! The file, NULL if closed
+		FILE* _file;
+
+		//! Buffer for encoding the hands
+		vector<unsigned char> _buffer;
+
+		// Write a record
+		bool writeRecord(uint32_t kind,int64_t frameID,int32_t timestamp,const void* payload,uint32_t length);
+
+	public:
+		/*!
+		 * \brief Constructor
+		 */
+		LeapCaptureWriter(void) : _file(0) {}
+
+		/*!
+		 * \brief Destructor (closes the file)
+		 */
+		~LeapCaptureWriter(void) {close();}
+
+		/*!
+		 * \brief Create a capture file (replaces an existing file)
+		 * \param[in] path : the path of the file
+		 * \return true if success
+		 */
+		bool open(const string& path);
+
+		/*!
+		 * \brief Close the file
+		 */
+		void close();
+
+		/*!
+		 * \brief Check if a file is open
+		 * \return true if open
+		 */
+		inline bool isOpen() const {return (_file != 0);}
+
+		/*!
+		 * \brief Write the hands of a frame
+		 * \param[in] frameID : the id of the frame
+		 * \param[in] timestamp : the time of the frame since the beginning of the capture, in milliseconds
+		 * \param[in] hands : the hands of the frame
+		 * \return true if success
+		 */
+		bool writeHands(int64_t frameID,int32_t timestamp,const vector<LeapHandSample>& hands);
+
+#ifdef LG_WITH_LEAP
+		/*!
+		 * \brief Write a serialized Leap::Frame
+		 * \param[in] frame : the frame
+		 * \param[in] timestamp : the time of the frame since the beginning of the capture, in milliseconds
+		 * \return true if success
+		 */
+		bool writeFrame(const Leap::Frame& frame,int32_t timestamp);
+#endif
+	};
+
+	/*!
+	 * \class LeapCaptureFile
+	 * \brief Capture file mapped in memory (read in memory where mmap is not available).
+	 * The records are indexed when the file is opened and read in place : getting a record copies nothing.
+	*/
+	class LeapCaptureFile
+	{
+	private:
+		//! Content of the file
+		const unsigned char* _data;
+
+		//! Size of the file in bytes
+		size_t _size;
+
+		//! Information whether _data is a mapping (or an allocated copy)
+		bool _mapped;
+
+		//! Offsets of the records in the file
+		vector<size_t> _offsets;
+
+		//! Description of the last error
+		string _error;
+
+	public:
+		/*!
+		 * \brief Constructor
+		 */
+		LeapCaptureFile(void) : _data(0),_size(0),_mapped(false) {}
+
+		/*!
+		 * \brief Destructor (closes the file)
+		 */
+		~LeapCaptureFile(void) {close();}
+
+		/*!
+		 * \brief Map a capture file and index its records
+		 * \param[in] path : the path of the file
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool open(const string& path);
+
+		/*!
+		 * \brief Unmap the file
+		 */
+		void close();
+
+		/*!
+		 * \brief Get the number of records
+		 * \return Number of complete records (a record truncated at the end of the file is ignored)
+		 */
+		inline size_t getRecordCount() const {return _offsets.size();}
+
+		/*!
+		 * \brief Get a record
+		 * \param[in] index : between 0 and getRecordCount() - 1
+		 * \return The record, valid until the file is closed
+		 */
+		inline const LeapCaptureRecord* getRecord(size_t index) const {return reinterpret_cast<const LeapCaptureRecord*>(_data + _offsets[index]);}
+
+		/*!
+		 * \brief Decode the hands of a record of kind LG_LEAP_CAPTURE_HANDS
+		 * \param[in] record : the record
+		 * \param[out] hands : the hands of the frame
+		 * \return true if success
+		 */
+		static bool decodeHands(const LeapCaptureRecord* record,vector<LeapHandSample>& hands);
+
+		/*!
+		 * \brief Get the last error
+		 * \return A description of the last error
+		 */
+		inline string getLastError() const {return _error;}
+	};
+
+	/*!
+	 * \class LeapReplaySource
+	 * \brief Source of frames of a LeapGenerator replaying a capture file, for testing a pipeline without device.
+	 * At recorded speed, each poll gives the last frame whose time has come (like a device, frames between two polls are skipped).
+	 * At maximum speed, each poll gives the next frame. Example : new LeapGenerator("replay",new LeapReplaySource("hands.lgcap",false)).
+	*/
+	class LeapReplaySource : public LeapFrameSource
+	{
+	private:
+		//! The path of the capture file
+		string _path;
+
+		//! Information whether the frames are replayed at recorded speed (or at maximum speed)
+		bool _realTime;
+
+		//! Information whether the replay starts again at the end of the file
+		bool _loop;
+
+		//! The capture file
+		LeapCaptureFile _file;
+
+		//! Index of the next record
+		size_t _next;
+
+		//! Number of times the capture has been replayed entirely
+		int _loops;
+
+		//! Time of the replay
+		Timer _timer;
+
+		//! Time of the replay at the beginning of the current loop
+		int _loopStart;
+
+#ifdef LG_WITH_LEAP
+		//! Frame receiving the serialized frames
+		Leap::Frame* _frame;
+
+		//! Controller needed for deserializing the frames
+		Leap::Controller* _controller;
+#endif
+
+		// Decode a record, return false if it holds no hands this build can read
+		bool decode(const LeapCaptureRecord* record,vector<LeapHandSample>& hands);
+
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param[in] path : the path of the capture file
+		 * \param[in] realTime : true for replaying at recorded speed, false for replaying a frame at each poll
+		 * \param[in] loop : true for starting again at the end of the file
+		 */
+		LeapReplaySource(string path,bool realTime = true,bool loop = false);
+
+		/*!
+		 * \brief Destructor
+		 */
+		~LeapReplaySource(void);
+
+		/*!
+		 * \brief Check if all the frames have been replayed (never true when looping)
+		 * \return true at the end of the capture
+		 */
+		inline bool isFinished() const {return ((!_loop)&&(_next >= _file.getRecordCount()));}
+
+		/*!
+		 * \brief Get the number of times the capture has been replayed entirely
+		 * \return Number of loops
+		 */
+		inline int getLoops() const {return _loops;}
+
+		/*!
+		 * \brief Get the last error of the capture file
+		 * \return A description of the last error
+		 */
+		inline string getLastError() const {return _file.getLastError();}
+
+		bool open();
+		void close();
+		bool poll(long long& frameID,vector<LeapHandSample>& hands);
+		LeapFrameSource* clone() const;
+	};
+
+	/*!
+	 * \class LeapRecordingSource
+	 * \brief Source of frames writing in a capture file the hands given by another source.
+	*/
+	class LeapRecordingSource : public LeapFrameSource
+	{
+	private:
+		//! The recorded source (owned)
+		LeapFrameSource* _source;
+
+		//! The path of the capture file
+		string _path;
+
+		//! The capture file
+		LeapCaptureWriter _writer;
+
+		//! Time of the capture
+		Timer _timer;
+
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param[in] source : the recorded source (deleted by the LeapRecordingSource)
+		 * \param[in] path : the path of the capture file
+		 */
+		LeapRecordingSource(LeapFrameSource* source,string path) : _source(source),_path(path),_timer("ms") {}
+
+		/*!
+		 * \brief Destructor
+		 */
+		~LeapRecordingSource(void) {delete _source;}
+
+		bool open();
+		void close();
+		bool poll(long long& frameID,vector<LeapHandSample>& hands);
+		LeapFrameSource* clone() const;
+	};
+}
+
+#endif /* LGLEAPCAPTURE_H_ */
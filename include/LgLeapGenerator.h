@@ -0,0 +1,284 @@
+#pragma once
+
+/*!
+ * \file LgLeapGenerator.h
+ * \brief File containing the LeapGenerator class, a Generator of hand joints from a Leap Motion controller (or from a mock source).
+ * \version 0.2
+ * \date 19 october 2026
+ */
+
+#ifndef LGLEAPGENERATOR_H_
+#define LGLEAPGENERATOR_H_
+
+/*!
+* \brief Index of the palm in the joints of a LeapHandSample
+*/
+#define LG_LEAP_JOINT_PALM 0
+
+/*!
+* \brief Index of the wrist in the joints of a LeapHandSample
+*/
+#define LG_LEAP_JOINT_WRIST 1
+
+/*!
+* \brief Index of the elbow in the joints of a LeapHandSample
+*/
+#define LG_LEAP_JOINT_ELBOW 2
+
+/*!
+* \brief Index of the thumb tip in the joints of a LeapHandSample (the other fingers follow : index, middle, ring, pinky)
+*/
+#define LG_LEAP_JOINT_THUMB 3
+
+/*!
+* \brief Number of joints of a LeapHandSample
+*/
+#define LG_LEAP_JOINT_COUNT 8
+
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "LgGenerator.h"
+
+#ifdef LG_WITH_LEAP
+namespace Leap
+{
+	class Controller;
+	class Hand;
+}
+#endif
+
+using namespace std;
+
+/*!
+ * \namespace lg
+ * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
+*/
+namespace lg
+{
+	/*!
+	 * \brief Joints of a hand seen in a frame, already in libGina coordinates (millimeters and radians, as given by the Leap Motion)
+	*/
+	struct LeapHandSample
+	{
+		//! Id of the hand, kept while the hand stays in the field of view
+		int id;
+
+		//! Information whether it is a right hand
+		bool right;
+
+		//! Confidence of the tracking, between 0 and 1
+		float confidence;
+
+		//! Positions of the joints (LG_LEAP_JOINT_PALM, LG_LEAP_JOINT_WRIST ...)
+		Point3D positions[LG_LEAP_JOINT_COUNT];
+
+		//! Orientations of the joints (Euler angles : rotation around X, then Y, then Z)
+		Point3D orientations[LG_LEAP_JOINT_COUNT];
+
+		LeapHandSample() : id(0),right(true),confidence(0.0f) {}
+	};
+
+	/*!
+	 * \class LeapFrameSource
+	 * \brief Mother class of the sources of frames of a LeapGenerator.
+	 * A source converts its frames into LeapHandSample, so the LeapGenerator does not depend on the Leap Motion SDK.
+	*/
+	class LeapFrameSource
+	{
+	public:
+		/*!
+		 * \brief Destructor
+		 */
+		virtual ~LeapFrameSource(void) {}
+
+		/*!
+		 * \brief Connect to the device
+		 * \return true if success
+		 */
+		virtual bool open() = 0;
+
+		/*!
+		 * \brief Disconnect from the device
+		 */
+		virtual void close() = 0;
+
+		/*!
+		 * \brief Get the hands of the last frame, if it has not been polled yet
+		 * \param[out] frameID : the id of the frame
+		 * \param[out] hands : the hands of the frame (resized, its LeapHandSample are reused)
+		 * \return true if there is a new frame
+		 */
+		virtual bool poll(long long& frameID,vector<LeapHandSample>& hands) = 0;
+
+		/*!
+		 * \brief Get a new source of the same kind (for cloning a LeapGenerator)
+		 * \return A pointer to the new source
+		 */
+		virtual LeapFrameSource* clone() const = 0;
+	};
+
+	/*!
+	 * \class MockLeapSource
+	 * \brief Source of frames without device, for building and testing a pipeline of LeapGenerator.
+	 * Gives the frames pushed with pushFrame first, then synthetic hands moving on circles (one new frame at each poll).
+	*/
+	class MockLeapSource : public LeapFrameSource
+	{
+	private:
+		//! Number of synthetic hands (0, 1 right hand or 2 hands)
+		int _handCount;
+
+		//! Frames given before the synthetic ones
+		deque<vector<LeapHandSample> > _frames;
+
+		//! Id of the last frame
+		long long _frame;
+
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param[in] handCount : the number of synthetic hands (0, 1 right hand or 2 hands)
+		 */
+		MockLeapSource(int handCount = 1) : _handCount(handCount),_frame(0) {}
+
+		/*!
+		 * \brief Add a frame to give before the synthetic ones
+		 * \param[in] hands : the hands of the frame
+		 */
+		inline void pushFrame(const vector<LeapHandSample>& hands) {_frames.push_back(hands);}
+
+		bool open();
+		void close();
+		bool poll(long long& frameID,vector<LeapHandSample>& hands);
+		LeapFrameSource* clone() const;
+	};
+
+#ifdef LG_WITH_LEAP
+	/*!
+	 * \brief Fill the joints of a LeapHandSample from a Leap::Hand (palm, arm and distal bones of the fingers)
+	 * \param[in] hand : the hand of a Leap::Frame
+	 * \param[out] sample : the joints of the hand
+	 */
+	void convertLeapHand(const Leap::Hand& hand,LeapHandSample& sample);
+
+	/*!
+	 * \class LeapControllerSource
+	 * \brief Source of frames reading a Leap::Controller (needs the Leap Motion SDK, built with LG_WITH_LEAP).
+	*/
+	class LeapControllerSource : public LeapFrameSource
+	{
+	private:
+		//! The controller, created by open
+		Leap::Controller* _controller;
+
+		//! Id of the last polled frame
+		long long _lastFrame;
+
+	public:
+		/*!
+		 * \brief Constructor
+		 */
+		LeapControllerSource(void) : _controller(0),_lastFrame(-1) {}
+
+		/*!
+		 * \brief Destructor
+		 */
+		~LeapControllerSource(void) {close();}
+
+		bool open();
+		void close();
+		bool poll(long long& frameID,vector<LeapHandSample>& hands);
+		LeapFrameSource* clone() const;
+	};
+#endif
+
+	/*!
+	 * \class LeapGenerator
+	 * \brief Generator of the joints of the hands seen by a Leap Motion.
+	 * Each hand is a Group3D (named LEAP_HAND_ followed by the id of the hand), containing the palm, wrist, elbow and finger tips
+	 * as LG_ORIENTEDPOINT3D_RIGHT_HAND, LG_ORIENTEDPOINT3D_RIGHT_WRIST, LG_ORIENTEDPOINT3D_RIGHT_THUMB ... (LEFT for a left hand).
+	 * The Group of a hand is removed when the hand leaves the field of view.
+	 * Each new frame is converted in a single pass : the names of the types and of the Groups are computed once, not at each frame.
+	*/
+	class LeapGenerator : public Generator
+	{
+	private:
+		//! The source of frames (owned)
+		LeapFrameSource* _source;
+
+		//! Hands of the last frame, reused at each frame
+		vector<LeapHandSample> _hands;
+
+		//! Names of the Groups of the hands in the field of view, stored by hand ids
+		map<int, string> _groupNames;
+
+		//! Id of the last converted frame
+		long long _lastFrame;
+
+		//! Information whether each joint of each side (0 left, 1 right) is generated (see Generator::onlyGenerate)
+		bool _generatedJoints[2][LG_LEAP_JOINT_COUNT];
+
+		// Check if a type is generated, without the exception of Generator::isGenerated for the types not listed in onlyGenerate
+		bool generates(const string& type) const;
+
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param[in] name : a name for the instance of this Node
+		 * \param[in] source : the source of frames (deleted by the LeapGenerator), a MockLeapSource if NULL
+		 */
+		LeapGenerator(string name,LeapFrameSource* source = 0);
+
+		/*!
+		 * \brief Destructor
+		 */
+		~LeapGenerator(void);
+
+		/*!
+		 * \brief Get the type of a joint
+		 * \param[in] joint : the joint (LG_LEAP_JOINT_PALM ...)
+		 * \param[in] right : true for a right hand
+		 * \return The type (LG_ORIENTEDPOINT3D_RIGHT_HAND ...)
+		 */
+		static const string& getJointType(int joint,bool right);
+
+		/*!
+		 * \brief Get the id of the last converted frame
+		 * \return The id of the frame, -1 if there is none
+		 */
+		inline long long getLastFrame() const {return _lastFrame;}
+
+		Node* clone(string cloneName) const;
+
+		/*!
+		 * \brief Connect the source of frames
+		 * \return true if success
+		 */
+		bool start();
+
+		/*!
+		 * \brief Disconnect the source of frames
+		 * \return true
+		 */
+		bool stop();
+
+		/*!
+		 * \brief Convert the hands of the last frame (nothing if there is no new frame)
+		 * \param[in] groups3D : Groups of HOrientedPoint3D (one by hand)
+		 * \return true if success
+		 */
+		bool generate(map<string,Group3D*>& groups3D,map<string,Group2D*>&,map<string,Group1D*>&,map<string,GroupSwitch*>&);
+
+		/*!
+		 * \brief Return the types of the joints of both hands (restrained by onlyGenerate)
+		 * \return A set of type
+		 */
+		set<string> produce() const;
+	};
+}
+
+#endif /* LGLEAPGENERATOR_H_ */
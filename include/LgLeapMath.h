@@ -0,0 +1,170 @@
+#pragma once
+
+/*!
+ * \file LgLeapMath.h
+ * \brief File containing the conversions between the Leap Motion math types (Leap::Vector, Leap::Matrix) and Point3D, without copy when possible.
+ * \version 0.2
+ * \date 19 october 2026
+ */
+
+#ifndef LGLEAPMATH_H_
+#define LGLEAPMATH_H_
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <type_traits>
+#include <vector>
+
+#include "LeapMath.h"
+#include "LgPoint3D.h"
+
+using namespace std;
+
+/*!
+ * \namespace lg
+ * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
+*/
+namespace lg
+{
+	// Leap::Vector and Point3D are both three contiguous floats (x, y, z) : a reference on one is a view on the other
+	static_assert(sizeof(Point3D) == 3*sizeof(float),"libGina : Point3D must hold exactly three floats.");
+	static_assert(sizeof(Leap::Vector) == sizeof(Point3D),"libGina : Leap::Vector and Point3D must have the same size.");
+	static_assert(is_standard_layout<Point3D>::value && is_standard_layout<Leap::Vector>::value,"libGina : Leap::Vector and Point3D must have a standard layout.");
+	static_assert((offsetof(Leap::Vector,x) == 0)&&(offsetof(Leap::Vector,y) == sizeof(float))&&(offsetof(Leap::Vector,z) == 2*sizeof(float)),"libGina : Leap::Vector must store x, y, z in this order.");
+
+	/*!
+	 * \brief View a Leap::Vector as a Point3D (no copy)
+	 * \param[in] vector : the vector
+	 * \return The same memory, as a Point3D
+	 */
+	inline const Point3D& asPoint3D(const Leap::Vector& vector) {return *reinterpret_cast<const Point3D*>(&vector);}
+	inline Point3D& asPoint3D(Leap::Vector& vector) {return *reinterpret_cast<Point3D*>(&vector);}
+
+	/*!
+	 * \brief View an array of Leap::Vector as an array of Point3D (no copy)
+	 * \param[in] vectors : the first vector
+	 * \return The same memory, as Point3D
+	 */
+	inline const Point3D* asPoint3D(const Leap::Vector* vectors) {return reinterpret_cast<const Point3D*>(vectors);}
+	inline Point3D* asPoint3D(Leap::Vector* vectors) {return reinterpret_cast<Point3D*>(vectors);}
+
+	/*!
+	 * \brief View a Point3D as a Leap::Vector (no copy)
+	 * \param[in] point : the point
+	 * \return The same memory, as a Leap::Vector
+	 */
+	inline const Leap::Vector& asLeapVector(const Point3D& point) {return *reinterpret_cast<const Leap::Vector*>(&point);}
+	inline Leap::Vector& asLeapVector(Point3D& point) {return *reinterpret_cast<Leap::Vector*>(&point);}
+
+	/*!
+	 * \brief View an array of Point3D as an array of Leap::Vector (no copy)
+	 * \param[in] points : the first point
+	 * \return The same memory, as Leap::Vector
+	 */
+	inline const Leap::Vector* asLeapVector(const Point3D* points) {return reinterpret_cast<const Leap::Vector*>(points);}
+	inline Leap::Vector* asLeapVector(Point3D* points) {return reinterpret_cast<Leap::Vector*>(points);}
+
+	/*!
+	 * \brief Copy an array of Leap::Vector in an array of Point3D (a single copy of memory)
+	 * \param[in] vectors : the vectors
+	 * \param[in] count : the number of vectors
+	 * \param[out] points : the points (count values)
+	 */
+	inline void toPoint3D(const Leap::Vector* vectors,size_t count,Point3D* points)
+	{
+		if(count > 0) memcpy(reinterpret_cast<float*>(points),&vectors[0].x,3*count*sizeof(float));
+	}
+
+	/*!
+	 * \brief Copy an array of Leap::Vector in an array of Point3D, changing their unit (millimeters to meters with 0.001 ...)
+	 * All the coordinates are processed as a single array of floats, which the compiler can vectorize.
+	 * \param[in] vectors : the vectors
+	 * \param[in] count : the number of vectors
+	 * \param[in] scale : the factor applied on every coordinate
+	 * \param[out] points : the points (count values)
+	 */
+	inline void toPoint3D(const Leap::Vector* vectors,size_t count,float scale,Point3D* points)
+	{
+		const float* input = (count > 0) ? &vectors[0].x : 0;
+		float* output = reinterpret_cast<float*>(points);
+		for(size_t i = 0;i < 3*count;i++) output[i] = input[i]*scale;
+	}
+
+	/*!
+	 * \brief Copy an array of Point3D in an array of Leap::Vector (a single copy of memory)
+	 * \param[in] points : the points
+	 * \param[in] count : the number of points
+	 * \param[out] vectors : the vectors (count values)
+	 */
+	inline void toLeapVector(const Point3D* points,size_t count,Leap::Vector* vectors)
+	{
+		if(count > 0) memcpy(&vectors[0].x,reinterpret_cast<const float*>(points),3*count*sizeof(float));
+	}
+
+	/*!
+	 * \brief Convert a basis (the orientation of a Leap::Hand, Leap::Arm or Leap::Bone) to a 3D orientation
+	 * The orientation is given as Euler angles in radians, rotation around X, then Y, then Z (as interpolated by interpolateOrientation).
+	 * The left-handed bases of the left hands are mirrored on their X axis first.
+	 * \param[in] basis : the basis (its origin is ignored)
+	 * \return The Euler angles
+	 */
+	inline Point3D toEulerAngles(const Leap::Matrix& basis)
+	{
+		Leap::Vector x = basis.xBasis;
+		if(x.dot(basis.yBasis.cross(basis.zBasis)) < 0.0f) x = -x;
+
+		// Columns of the rotation Rz*Ry*Rx are the bases
+		float sinY = -x.z;
+		if(sinY > 1.0f) sinY = 1.0f;
+		if(sinY < -1.0f) sinY = -1.0f;
+		return Point3D((float)atan2(basis.yBasis.z,basis.zBasis.z),(float)asin(sinY),(float)atan2(x.y,x.x));
+	}
+
+	/*!
+	 * \brief Convert an array of bases to 3D orientations (see toEulerAngles(const Leap::Matrix&))
+	 * \param[in] bases : the bases
+	 * \param[in] count : the number of bases
+	 * \param[out] angles : the Euler angles (count values)
+	 */
+	inline void toEulerAngles(const Leap::Matrix* bases,size_t count,Point3D* angles)
+	{
+		for(size_t i = 0;i < count;i++) angles[i] = toEulerAngles(bases[i]);
+	}
+
+	/*!
+	 * \brief Convert a 3D orientation to a basis (inverse of toEulerAngles)
+	 * \param[in] angles : the Euler angles in radians, rotation around X, then Y, then Z
+	 * \return The basis (origin at 0)
+	 */
+	inline Leap::Matrix toBasis(const Point3D& angles)
+	{
+		float cx = cosf(angles.getX()),sx = sinf(angles.getX());
+		float cy = cosf(angles.getY()),sy = sinf(angles.getY());
+		float cz = cosf(angles.getZ()),sz = sinf(angles.getZ());
+		return Leap::Matrix(Leap::Vector(cz*cy,sz*cy,-sy),
+			Leap::Vector(cz*sy*sx - sz*cx,sz*sy*sx + cz*cx,cy*sx),
+			Leap::Vector(cz*sy*cx + sz*sx,sz*sy*cx - cz*sx,cy*cx));
+	}
+
+	/*!
+	 * \brief Get the tip positions of a whole list of pointables (Leap::PointableList, Leap::FingerList or Leap::ToolList)
+	 * \param[in] list : the list
+	 * \param[out] positions : the positions, in the order of the list
+	 * \return The number of positions
+	 */
+	template <typename L> size_t getTipPositions(const L& list,vector<Point3D>& positions)
+	{
+		int count = list.count();
+		positions.resize((count > 0) ? count : 0);
+		for(int i = 0;i < count;i++)
+		{
+			const Leap::Vector tip = list[i].tipPosition();
+			positions[i] = asPoint3D(tip);
+		}
+		return positions.size();
+	}
+}
+
+#endif /* LGLEAPMATH_H_ */
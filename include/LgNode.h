@@ -83,11 +83,14 @@ namespace lg
 		 * \brief Get a pointer to an instance of this Node
 		 * 
 		 * Virtual function returning a pointer to a Node.
-		 * Useful for implementing a NodeFactory.
+		 * Useful for implementing a NodeFactory, and used by a Scheduler for cloning a Node per Group (see Scheduler::setSharded).
+		 * The clone must be a new instance, never this : it has the configuration of this Node (parameters, filters ...)
+		 * but its own state (historic of a filter, opened devices ...), so both can be updated at the same time without sharing anything.
+		 * The clone is not started : start is called on it before its first update.
 		 *
 		 * \param[in] cloneName : the name of the clone to retrieve
 		 *
-		 * \return A pointer to an instance of this Node
+		 * \return A pointer to a new instance of this Node, NULL if this Node cannot be cloned
 		 */
 		virtual Node* clone(string cloneName) const = 0;
 
@@ -192,6 +195,22 @@ namespace lg
 
 
 	};
+
+	/*!
+	 * \brief Copy the filters on the Groups and the types of a Processor or an Observer (for implementing clone)
+	 * The filters are members of both classes, which declare this function as a friend.
+	 * \param[out] copy : the Node receiving the filters
+	 * \param[in] original : the Node whose filters are copied
+	 */
+	template <typename N> inline void copyNodeFilters(N& copy,const N& original)
+	{
+		copy._observedGroups = original._observedGroups;
+		copy._observedGroupType = original._observedGroupType;
+		copy._observedPointType = original._observedPointType;
+		copy._ignoredGroups = original._ignoredGroups;
+		copy._ignoredGroupType = original._ignoredGroupType;
+		copy._ignoredPointType = original._ignoredPointType;
+	}
 }
 
 #endif /* LGNODE_H_ */
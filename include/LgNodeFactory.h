@@ -2,7 +2,7 @@
 
 /*!
  * \file LgNodeFactory.h
- * \brief File containing the NodeFactory class, factory for getting new instance of Node 
+ * \brief File containing the NodeFactory class, factory for getting new instance of Node
  * \author Bremard Nicolas
  * \version 0.2
  * \date 02 july 2014
@@ -11,41 +11,92 @@
 #ifndef LGNODEFACTORY_H_
 #define LGNODEFACTORY_H_
 
+/*!
+* \brief Name of the function creating a Node in a plugin file (see create_t and LG_EXPORT_NODE)
+*/
+#define LG_NODE_FACTORY_SYMBOL "create"
+
+#if defined _WIN32  || defined _WIN64
+#include "windows.h"
+#define LG_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#include <dlfcn.h>
+#define LG_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+/*!
+* \brief Declare the function creating a Node in a plugin file : LG_EXPORT_NODE(MyProcessor) in one of its source files
+* The class must have a constructor taking the name of the Node.
+*/
+#define LG_EXPORT_NODE(NodeClass) extern "C" LG_PLUGIN_EXPORT lg::Node* create() {return new NodeClass(#NodeClass);}
+
 #include <map>
 #include <string>
-#include <windows.h>
+#include <utility>
+#include <vector>
 
 #include "LgNode.h"
 
 using namespace std;
 
-/*! 
+/*!
  * \namespace lg
  * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
 */
 namespace lg
 {
+	/*!
+	* \brief Type for loading a Node from a file (it is the declared extern function)
+	*/
+	typedef Node* create_t();
+
+#if defined _WIN32  || defined _WIN64
+	/*!
+	* \brief Handle of a loaded plugin file
+	*/
+	typedef HINSTANCE LibraryHandle;
+#else
+	/*!
+	* \brief Handle of a loaded plugin file
+	*/
+	typedef void* LibraryHandle;
+#endif
+
 	/*!
 	 * \class NodeFactory
 	 * \brief Class for managing Node and getting new instance from them by name, used for loading Node from dll/so/dylib file
+	 * A plugin file is loaded once (even if registered under several names), and its create function is resolved once when registered :
+	 * create then only calls the cached function.
 	*/
 	class NodeFactory
 	{
 	private:
 
 		//! Save the instance of loaded Node
-		static map<string,HINSTANCE> _instances;
+		static map<string,LibraryHandle> _instances;
 
 		//! Registered Node in the NodeFactory
 		static map<string,Node*> _nodes;
 
+		//! Functions creating the Node loaded from files, stored by Node names
+		static map<string,create_t*> _factories;
+
+		//! Loaded files and the number of Node names registered from each of them, stored by paths
+		static map<string,pair<LibraryHandle,int> > _libraries;
+
+		//! Paths of the files of the Node loaded from files, stored by Node names
+		static map<string,string> _paths;
+
 		//! Counter for giving new name to clones and making them unique
 		static int _cloneCounter;
 
+		//! Description of the last error
+		static string _error;
+
 	public:
 		/*!
 		 * \brief Register a new Node with its pointer
-		 * 
+		 *
 		 * Register a new Node for creating instances just by name.
 		 * The pointer is used here, it is the normal way to register a class in the NodeFactory when you have its implementation.
 		 *
@@ -56,40 +107,74 @@ namespace lg
 
 		/*!
 		 * \brief Register a new Node from its file
-		 * 
+		 *
 		 * Register a new Node for creating instances just by name.
 		 * The file is used here, it is the way to register a class in the NodeFactory when you have its file.
 		 * Saving a Node in a file is useful when you don't want to make the code public by example.
+		 * The file must declare the function create (see LG_EXPORT_NODE). EXTENSION (.so, .dylib or .dll) is added to a path without extension.
+		 * On Linux, the file finds libGina in the application, which must export its symbols (linked with -rdynamic).
 		 *
 		 * \param[in] genericNodeName : the name of the Node to which refer when calling create
 		 * \param[in] filePath : the path of the Node to load
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		static bool registerNodeFromFile(const string& genericNodeName,const string& filePath);
+
+		/*!
+		 * \brief Register several Nodes from their files
+		 *
+		 * All the files are prefetched from the disk first (concurrently, by the system), then loaded and registered in order.
+		 *
+		 * \param[in] files : the names of the Nodes and the paths of their files (see registerNodeFromFile)
+		 * \return true if all the Nodes have been registered, false in other cases (use getLastError() for getting the problem)
 		 */
-		static void registerNodeFromFile(const string& genericNodeName,string& filePath);
+		static bool registerNodesFromFiles(const vector<pair<string,string> >& files);
+
+		/*!
+		 * \brief Register the Nodes listed in a configuration file
+		 *
+		 * Each line gives the name of a Node and the path of its file : "MyProcessor = plugins/libmyprocessor".
+		 * Empty lines and lines starting with # or ; are ignored.
+		 * The Nodes are registered with registerNodesFromFiles, in the order of the lines.
+		 *
+		 * \param[in] configPath : the path of the configuration file
+		 * \return true if all the Nodes have been registered, false in other cases (use getLastError() for getting the problem)
+		 */
+		static bool registerNodesFromConfig(const string& configPath);
 
 		/*!
 		 * \brief Unregister a Node by its name
-		 * 
+		 *
 		 * Unregister a Node from the NodeFactory
-		 * If the file has been loaded, it is unloaded.
+		 * If the file has been loaded, it is unloaded (once no other registered Node comes from it) : the instances created from it must be deleted before.
 		 *
 		 * \param[in] genericNodeName : the name of the Node to unregister
 		 */
 		static void unregister(const string& genericNodeName);
 
+		/*!
+		 * \brief Check if a Node is registered
+		 * \param[in] genericNodeName : the name of the Node
+		 * \return true if the Node can be created
+		 */
+		static bool isRegistered(const string& genericNodeName);
+
 		/*!
 		 * \brief Get an instance of a Node by calling its name
 		 *
+		 * A Node loaded from a file is created by the function of its file, the others are cloned (see Node::clone).
+		 *
 		 * \param[in] genericNodeName : the name of the Node from which to get an instance
-		 * \return A pointer to a new instance of the wanted Node, the same instance if the Node cannot be cloned
+		 * \return A pointer to a new instance of the wanted Node, NULL if the Node is not registered or cannot be cloned (use getLastError() for getting the problem)
 		 */
-		Node* create(const string& genericNodeName) const;
+		static Node* create(const string& genericNodeName);
 
+		/*!
+		 * \brief Get the last error
+		 * \return A description of the last error
+		 */
+		static string getLastError();
 	};
-
-	/*!
-	* \brief Type for loading a Node from a file (it is the declared extern function)
-	*/
-	typedef Node* create_t();
 }
 
 #endif /* LGNODEFACTORY_H_ */
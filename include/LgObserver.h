@@ -67,6 +67,11 @@ namespace lg
 		// Update the probability of the given group with the given value
 		void updateProbability(string groupID,float newValue);
 
+		// Copy the filters of another Observer (for implementing clone)
+		inline void copyFilters(const Observer& original) {copyNodeFilters(*this,original);}
+
+		template <typename N> friend void copyNodeFilters(N& copy,const N& original);
+
 	public:
 		/*!
 		 * \brief Constructor for creating a new Generator
@@ -209,4 +214,4 @@ namespace lg
 
 	};
 }
-#endif /* LGOBSERVER_H_ */
\ No newline at end of file
+#endif /* LGOBSERVER_H_ */
\ No newline at end of file
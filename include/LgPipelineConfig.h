@@ -0,0 +1,162 @@
+#pragma once
+
+/*!
+ * \file LgPipelineConfig.h
+ * \brief File containing the PipelineConfig class, which reads the description of a pipeline (settings, Nodes, filters, historic policies) from a file and applies it to a Scheduler.
+ * \version 0.2
+ * \date 19 october 2026
+ */
+
+#ifndef LGPIPELINECONFIG_H_
+#define LGPIPELINECONFIG_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "LgScheduler.h"
+
+using namespace std;
+
+/*!
+ * \namespace lg
+ * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
+*/
+namespace lg
+{
+	/*!
+	 * \brief A Node described in a pipeline file
+	*/
+	struct PipelineNode
+	{
+		//! Unique name of the Node (name of its section)
+		string name;
+
+		//! Name of the Node in the NodeFactory
+		string genericName;
+
+		//! Priority of the Node, -1 for the first free priority
+		int priority;
+
+		//! Channels of the Node (LG_CHANNEL_3D | LG_CHANNEL_1D ...), -1 for the channels deduced from its types
+		int channels;
+
+		//! Information whether the Node is created once one of its inputs is held by a Group (see Scheduler::registerLazyNode)
+		bool lazy;
+
+		//! Inputs of a lazy Node
+		set<string> inputs;
+
+		//! Information whether the Node is cloned per Group (see Scheduler::setSharded)
+		bool sharded;
+
+		//! Filters of a Processor or an Observer (name of the function, argument), in the order of the file
+		vector<pair<string,string> > filters;
+
+		//! Line of the section in the file
+		int line;
+	};
+
+	/*!
+	 * \class PipelineConfig
+	 * \brief Description of a pipeline read from a file, for changing a deployment without recompiling.
+	 * The whole file is read and checked by load (unknown sections, keys or values are errors), then apply configures a Scheduler,
+	 * creates the Nodes from the NodeFactory, checks their compatibility and orders them (see Scheduler::prepare) before the first update.
+	 *
+	 * The file is made of sections of "key = value" lines (lists separated by spaces or commas, comments starting with # or ;) :
+	 * - [environment] : dataCopy, runtimeChanges (true or false), historicLength (default length), tryNumber
+	 * - [scheduler] : dirtyTracking, processorFusion, parallelStart, inputSkipping, cycleRejection (true or false), shardThreads (threads updating the clones of the
+	 *   sharded Nodes, 0 for one per core), affinity (CPUs of the thread applying the pipeline, which should be the thread updating the Scheduler)
+	 * - [plugins] : name of a Node in the NodeFactory = path of its file, relative to the pipeline file (see NodeFactory::registerNodeFromFile)
+	 * - [node uniqueName] : class (name in the NodeFactory, the unique name by default), priority, channels (3D 2D 1D SWITCH ALL),
+	 *   lazy (inputs of a Node created once one of them is present), sharded (true for a clone per Group), and the filters of Processors and Observers named as their functions :
+	 *   onlyProcessGroupIDs, onlyProcessGroupType, onlyProcessPointType, onlyObserveGroupIDs, onlyObserveGroupType, onlyObservePointType,
+	 *   ignoreGroupIDs, ignoreGroupType, ignorePointType (each value of a list is given to the function)
+	 * - [historic] : type = number of values kept (see Scheduler::setHistoricLength)
+	 * - [windows] : type = time window (see Scheduler::setHistoricWindow)
+	 * - [freshness] : type = freshness budget (see Scheduler::setFreshnessBudget)
+	 * - [statistics] : type = window and optionally smoothing (see Scheduler::enableStatistics)
+	*/
+	class PipelineConfig
+	{
+	private:
+		//! Path of the loaded file
+		string _path;
+
+		//! Settings of the [environment] and [scheduler] sections by names (booleans are 0 or 1)
+		map<string,int> _settings;
+
+		//! CPUs of the thread applying the pipeline
+		vector<int> _affinity;
+
+		//! Nodes to register in the NodeFactory and the paths of their files
+		vector<pair<string,string> > _plugins;
+
+		//! Nodes, in the order of the file
+		vector<PipelineNode> _nodes;
+
+		//! Lengths of historic by types
+		map<string,int> _historicLengths;
+
+		//! Time windows of historic by types
+		map<string,int> _historicWindows;
+
+		//! Freshness budgets by types
+		map<string,int> _freshnessBudgets;
+
+		//! Window and smoothing of the statistics by types
+		map<string,pair<int,float> > _statistics;
+
+		//! Description of the last error
+		string _error;
+
+		// Read a "key = value" line of a section, return false (with an error) if it is not valid
+		bool parseEntry(const string& section,const string& key,const string& value,int line);
+
+		// Give its filters to a Processor or an Observer, return false (with an error) if it does not have them
+		bool applyFilters(Node* node,const PipelineNode& description);
+
+	public:
+		/*!
+		 * \brief Constructor
+		 */
+		PipelineConfig(void) {}
+
+		/*!
+		 * \brief Read and check a pipeline file (replaces the previous description)
+		 * \param[in] path : the path of the file
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool load(const string& path);
+
+		/*!
+		 * \brief Configure a Scheduler (and its Environment) and create the Nodes of the pipeline
+		 * The Nodes are created by the Scheduler, which deletes them. If a step fails, the previous ones are kept.
+		 * \param[in] scheduler : the Scheduler, not started
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool apply(Scheduler* scheduler);
+
+		/*!
+		 * \brief Get the Nodes of the pipeline
+		 * \return The Nodes, in the order of the file
+		 */
+		inline const vector<PipelineNode>& getNodes() const {return _nodes;}
+
+		/*!
+		 * \brief Get the path of the loaded file
+		 * \return The path, empty if no file has been loaded
+		 */
+		inline string getPath() const {return _path;}
+
+		/*!
+		 * \brief Get the last error
+		 * \return A description of the last error
+		 */
+		inline string getLastError() const {return _error;}
+	};
+}
+
+#endif /* LGPIPELINECONFIG_H_ */
@@ -50,6 +50,11 @@ namespace lg
 			// Variable for ignoring types of points (if empty,unused -> observe all)
 			set<string> _ignoredPointType;
 
+			// Copy the filters of another Processor (for implementing clone)
+			inline void copyFilters(const Processor& original) {copyNodeFilters(*this,original);}
+
+			template <typename N> friend void copyNodeFilters(N& copy,const N& original);
+
 		public:
 
 			/*!
@@ -126,7 +131,37 @@ namespace lg
 			 */
 			inline bool isProcessedType(string processedType) const {return (((_observedPointType.size() == 0)||(_observedPointType.count(processedType)))&&(_ignoredPointType.count(processedType) == 0));} 
 
+			/*!
+			 * \brief Check if this Processor transforms some types in place
+			 * A Processor consuming and producing the same type rewrites the values of the existing HistoricTemplate (see rewriteLast)
+			 * instead of adding a new type (*_PROCESSED) : a chain of filters then does not duplicate the historics.
+			 * \return true if a type is both consumed and produced
+			 */
+			bool isInPlace() const
+			{
+				set<string> consumed = consume();
+				set<string> produced = produce();
+				for(set<string>::iterator it = consumed.begin();it != consumed.end();it++)
+					if(produced.count(*it)) return true;
+				return false;
+			}
+
+			/*!
+			 * \brief Replace the last value of an HistoricTemplate (in place transform)
+			 * The timestamp of the value is kept. A Scheduler notices the rewrite and increments the version of the HistoricTemplate.
+			 * \param[in] historic : the HistoricTemplate to modify
+			 * \param[in] value : the transformed value
+			 * \return true if success, false if the historic is empty
+			 */
+			template <typename H,typename T> static bool rewriteLast(H* historic,const T& value)
+			{
+				T* last = historic->getLast();
+				if(last == 0) return false;
+				*last = value;
+				return true;
+			}
+
 	};
 }
 
-#endif /* LGPROCESSOR_H_ */
\ No newline at end of file
+#endif /* LGPROCESSOR_H_ */
\ No newline at end of file
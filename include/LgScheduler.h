@@ -0,0 +1,1093 @@
+#pragma once
+
+/*!
+ * \file LgScheduler.h
+ * \brief File containing the Scheduler class, which registers Nodes in an Environment, keeps track of their dependencies and updates them.
+ * \version 0.2
+ * \date 19 october 2026
+ */
+
+#ifndef LGSCHEDULER_H_
+#define LGSCHEDULER_H_
+
+/*!
+* \brief Channel of the Switch Groups (see Scheduler::setChannels)
+*/
+#define LG_CHANNEL_SWITCH 1
+
+/*!
+* \brief Channel of the 1D Groups (see Scheduler::setChannels)
+*/
+#define LG_CHANNEL_1D 2
+
+/*!
+* \brief Channel of the 2D Groups (see Scheduler::setChannels)
+*/
+#define LG_CHANNEL_2D 4
+
+/*!
+* \brief Channel of the 3D Groups (see Scheduler::setChannels)
+*/
+#define LG_CHANNEL_3D 8
+
+/*!
+* \brief All the channels (Switch, 1D, 2D and 3D)
+*/
+#define LG_CHANNEL_ALL 15
+
+/*!
+* \brief Initial length of the Environment while some types are retained by time (see Scheduler::setHistoricWindow) : the Scheduler
+* doubles it whenever a window holds more than half of it, and it bounds the HistoricTemplate the Scheduler does not trim itself
+*/
+#define LG_HISTORIC_WINDOW_LENGTH 1024
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "LgEnvironment.h"
+#include "LgNode.h"
+#include "LgCompatibilityGraph.h"
+#include "LgGroupSlotMap.h"
+#include "LgHistoricRequirement.h"
+#include "LgStatistics.h"
+#include "LgThreadPool.h"
+
+using namespace std;
+
+/*!
+ * \namespace lg
+ * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
+*/
+namespace lg
+{
+	class FilterProcessor;
+
+	/*!
+	 * \brief Counters describing the work done by a Scheduler since it has been created (or since resetMetrics)
+	*/
+	struct SchedulerMetrics
+	{
+		//! Number of updates of the Scheduler (polling or event-driven)
+		unsigned long updates;
+
+		//! Number of Node updates actually performed
+		unsigned long nodeUpdates;
+
+		//! Number of Groups not delivered to a Node because one of its needed types was older than its freshness budget
+		unsigned long staleDrops;
+
+		//! Number of Node updates performed inside a fused chain of filters (not counted in nodeUpdates)
+		unsigned long fusedUpdates;
+
+		//! Number of Node updates skipped because none of their inputs was held by any Group
+		unsigned long skippedNodes;
+
+		//! Number of HistoricTemplate retained by time found full with all their values inside the window (the oldest may have been dropped)
+		unsigned long truncatedWindows;
+
+		SchedulerMetrics() : updates(0),nodeUpdates(0),staleDrops(0),fusedUpdates(0),skippedNodes(0),truncatedWindows(0) {}
+	};
+
+	/*!
+	 * \class Scheduler
+	 * \brief Class registering Nodes in an Environment while maintaining their CompatibilityGraph.
+	 * Every registration goes through the Environment (unique names and priorities follow its rules, and are checked against its registered
+	 * Nodes beforehand), then only the edges of the registered/unregistered Node are updated in the graph.
+	 * checkCompatibility() then reads the graph instead of re-checking every Node, which makes runtime changes
+	 * (see Environment::enableRuntimeChanges) cheap on a running Environment.
+	 *
+	 * The Scheduler also replaces Environment::update : it stores the Groups, and records a modification epoch for each
+	 * Group and each type of HistoricTemplate it contains. Processors and Observers only receive the Groups in which
+	 * one of their needed (or consumed) types changed since they last ran, and are not updated at all if there is none.
+	 * A Processor must therefore only write in the Groups it has been given.
+	 *
+	 * Besides polling update(), the Scheduler can be driven by events : when a Generator has new samples, calling update(generatorName)
+	 * only updates this Generator and the Nodes reachable from it through the need()/produce() edges of the CompatibilityGraph.
+	 * Sources running at different rates (a Leap Motion at 200 Hz, a depth camera at 30 Hz, switches on change) can then each drive
+	 * their own sub-pipeline from their own thread, the updates being serialized by the Scheduler.
+	 *
+	 * A freshness budget can be given to a type : when a Processor or an Observer needs it, the Groups in which its last value is
+	 * older than the budget (compared to the current time of the Scheduler) are not delivered, and are counted in the metrics.
+	 *
+	 * Nodes implementing HistoricRequirement declare the length of historic they need for some types or some Groups. Each HistoricTemplate
+	 * keeps the maximum length asked for its type or its Group (the default length if none), and is trimmed when it receives new values.
+	 * The length of the Environment is set to the maximum of all the lengths, so HistoricTemplate are never trimmed shorter than asked.
+	 * A type can also be retained by time (see setHistoricWindow and HistoricRequirement::historicWindows) : its values older than the window
+	 * are removed, so its memory is bounded by the rate of its Generator times the window. The Environment then only trims to
+	 * LG_HISTORIC_WINDOW_LENGTH values (or to the longest declared length), the Scheduler trims every modified HistoricTemplate itself,
+	 * and doubles the length of the Environment as soon as a window holds more than half of it, so the length follows the rates.
+	 *
+	 * Statistics can be enabled on a type (see enableStatistics) : each HistoricTemplate of this type then gets an HistoricStatistics,
+	 * updated with the new values only when the Scheduler notices them. Nodes read them with getStatistics (see getSchedulerOfEnvironment)
+	 * instead of iterating the historic at each update.
+	 *
+	 * Processors consuming and producing the same type transform it in place (see Processor::isInPlace and Processor::rewriteLast).
+	 * Each rewrite of the last value of an HistoricTemplate increments its version (see getVersion), so Observers know it was filtered.
+	 * Consecutive in place FilterProcessors on the same types are fused (see enableProcessorFusion) : the points of each Group are gathered once,
+	 * go through all the filters, then are written once (the version is then incremented once for the whole chain).
+	 *
+	 * Each Node only receives the channels (dimensions of Groups) it uses : they are deduced from the prefixes of its types
+	 * (LG_ORIENTEDPOINT3D_, LG_ORIENTEDPOINT2D_, LG_ORIENTEDPOINT1D_, LG_SWITCH_) or declared with setChannels.
+	 * The other channels are given as empty maps, so a 3D Node never walks the Switch, 1D and 2D Groups.
+	 *
+	 * The Scheduler counts the HistoricTemplate of each type held by the Groups, and keeps a bitmap of the present types.
+	 * With the input skipping option (see enableInputSkipping), Processors and Observers are not updated at all while none of their inputs
+	 * is present (an Observer of LG_ORIENTEDPOINT3D_RIGHT_HAND_PROCESSED before any hand shows up ...), which is counted in the metrics (skippedNodes).
+	 *
+	 * For a fast startup, the Nodes can be started concurrently by dependency level (see enableParallelStart), and Nodes loaded from
+	 * the NodeFactory can be created only once their inputs show up (see registerLazyNode).
+	 *
+	 * A stateful Processor or Observer can be cloned per Group (see setSharded) : each clone only receives the Groups of its id,
+	 * and the clones of a Node can be updated concurrently (see setShardThreads).
+	*/
+	class Scheduler
+	{
+	private:
+		/*!
+		 * \brief Modification state of an HistoricTemplate
+		 */
+		struct ElementState
+		{
+			//! Type of the HistoricTemplate
+			string type;
+
+			//! Bit of the type in the presence bitmap
+			size_t bit;
+
+			//! Last timestamp of the HistoricTemplate when it was checked
+			int lastTimestamp;
+
+			//! Number of values of the HistoricTemplate when it was checked
+			size_t size;
+
+			//! Fingerprint of the last value when it was checked (a value can be replaced at the same timestamp)
+			size_t fingerprint;
+
+			//! Number of times the last value has been rewritten in place (0 for a value as generated)
+			unsigned long version;
+		};
+
+		/*!
+		 * \brief Modification epochs of a Group
+		 */
+		struct GroupState
+		{
+			//! Epoch of the last modification of the Group
+			unsigned long epoch;
+
+			//! Epoch of the last modification of each type in the Group
+			map<string, unsigned long> types;
+
+			//! Last timestamp of each type in the Group
+			map<string, int> timestamps;
+
+			//! State of the HistoricTemplate of the Group, stored by their ids
+			map<string, ElementState> elements;
+
+			//! Statistics of the HistoricTemplate of the Group whose type has enabled statistics, stored by their ids
+			map<string, HistoricStatistics> statistics;
+
+			GroupState() : epoch(0) {}
+		};
+
+		/*!
+		 * \brief A stored Group and its modification epochs
+		 */
+		template <typename G> struct GroupSlot
+		{
+			//! The Group (owned by the map of Groups of its dimension)
+			G* group;
+
+			//! Modification epochs of the Group
+			GroupState state;
+
+			GroupSlot() : group(0) {}
+		};
+
+		/*!
+		 * \brief Slots of the Groups of a dimension
+		 * The Nodes still receive maps of Groups (the Node API is fixed), so the handles are also kept in the order of the ids : refreshing and
+		 * selecting the Groups walk the map and this order together instead of looking up each Group id.
+		 */
+		template <typename G> struct GroupSlots
+		{
+			//! Slots by Group ids
+			GroupSlotMap<GroupSlot<G> > slots;
+
+			//! Handles of the slots in the order of the Group ids (the order of the map of Groups when it was last refreshed)
+			vector<GroupHandle> sorted;
+		};
+
+		/*!
+		 * \brief A registered Node and what the Scheduler needs for updating it
+		 */
+		struct ScheduledNode
+		{
+			//! Unique name of the Node
+			string name;
+
+			//! Priority of the Node in the Environment (the schedule is sorted by priorities)
+			int priority;
+
+			//! The Node
+			Node* node;
+
+			//! Node is a Generator (always updated with all the Groups)
+			bool generator;
+
+			//! Node is a Processor (may add or remove Groups)
+			bool processor;
+
+			//! Types needed or consumed by the Node
+			set<string> inputs;
+
+			//! Types produced or consumed by the Node (ie types it can modify)
+			set<string> outputs;
+
+			//! Inputs of the Node which have a freshness budget, and their budgets
+			map<string, int> budgets;
+
+			//! Epoch at which the Node has been updated for the last time
+			unsigned long lastRun;
+
+			//! Filters fused with this Node, itself first (empty if the Node is not the head of a fused chain)
+			vector<FilterProcessor*> chain;
+
+			//! Positions in the schedule of the other Nodes of the fused chain
+			vector<size_t> followers;
+
+			//! Node is updated by the head of its fused chain
+			bool fused;
+
+			//! Channels of the Groups given to the Node (LG_CHANNEL_3D | LG_CHANNEL_2D ...)
+			int channels;
+
+			//! Information whether the Node is cloned per Group (see setSharded)
+			bool sharded;
+
+			//! Bits of the inputs in the presence bitmap
+			vector<unsigned long> inputBits;
+		};
+
+		/*!
+		 * \brief A Node waiting for one of its inputs before being created
+		 */
+		struct LazyNode
+		{
+			//! The name of the Node in the NodeFactory
+			string genericName;
+
+			//! The types of which one must be held by a Group
+			set<string> inputs;
+
+			//! The priority of the Node, -1 for the first free priority
+			int priority;
+		};
+
+		//! The Environment in which the Nodes are registered.
+		Environment* _environment;
+
+		//! Types exchanged by the registered Nodes.
+		CompatibilityGraph _graph;
+
+		//! Unique names of the registered Nodes.
+		map<Node*, string> _names;
+
+		//! Priorities of the registered Nodes (as in the Environment), for registering a Node without copying the maps of the Environment.
+		map<int, string> _priorities;
+
+		//! Counter for giving unique names to the Nodes registered without one.
+		int _nameCounter;
+
+		//! Registered Nodes ordered by their priorities, updated Node by Node when registering, rebuilt after other changes.
+		vector<ScheduledNode> _schedule;
+
+		//! Information whether the schedule must be rebuilt before the next update.
+		bool _scheduleChanged;
+
+		//! Information whether the schedule is being run (a Node registered meanwhile is scheduled by a rebuild).
+		bool _running;
+
+		//! Positions in the schedule of the Nodes reachable from each Generator, built on demand.
+		map<string, vector<size_t> > _subSchedules;
+
+		//! Serialize updates and registrations coming from several threads.
+		recursive_mutex _mutex;
+
+		//! Structure for storing Switch Data.
+		map<string, GroupSwitch*> _groupsSwitch;
+
+		//! Structure for storing 1D Data.
+		map<string, Group1D*> _groups1D;
+
+		//! Structure for storing 2D Data.
+		map<string, Group2D*> _groups2D;
+
+		//! Structure for storing 3D Data.
+		map<string, Group3D*> _groups3D;
+
+		//! Slots of the Switch Groups.
+		GroupSlots<GroupSwitch> _slotsSwitch;
+
+		//! Slots of the 1D Groups.
+		GroupSlots<Group1D> _slots1D;
+
+		//! Slots of the 2D Groups.
+		GroupSlots<Group2D> _slots2D;
+
+		//! Slots of the 3D Groups.
+		GroupSlots<Group3D> _slots3D;
+
+		//! Handles in the order of the Group ids, rebuilt while refreshing a dimension.
+		vector<GroupHandle> _sortedHandles;
+
+		//! Empty Switch Groups given to the Nodes which do not use this channel.
+		map<string, GroupSwitch*> _emptySwitch;
+
+		//! Empty 1D Groups given to the Nodes which do not use this channel.
+		map<string, Group1D*> _empty1D;
+
+		//! Empty 2D Groups given to the Nodes which do not use this channel.
+		map<string, Group2D*> _empty2D;
+
+		//! Empty 3D Groups given to the Nodes which do not use this channel.
+		map<string, Group3D*> _empty3D;
+
+		//! Channels declared with setChannels, stored by Node names.
+		map<string, int> _declaredChannels;
+
+		//! Bits of the types in the presence bitmap, given in the order the types are met.
+		map<string, size_t> _typeBits;
+
+		//! Number of HistoricTemplate of each type held by the Groups, by bits.
+		vector<unsigned int> _typeCounts;
+
+		//! Bitmap of the types held by at least one Group.
+		vector<unsigned long> _presence;
+
+		//! Current epoch, incremented before each Node update.
+		unsigned long _epoch;
+
+		//! Store whether Processors and Observers only receive the modified Groups.
+		bool _dirtyTracking;
+
+		//! Store whether consecutive in place filters are fused.
+		bool _fusion;
+
+		//! Store whether the Nodes whose inputs are held by no Group are skipped.
+		bool _inputSkipping;
+
+		//! Maximum age of the last value of a type for being delivered to a Node, stored by types.
+		map<string, int> _freshnessBudgets;
+
+		//! Number of values of the HistoricTemplate whose type and Group have no declared length.
+		int _defaultHistoricLength;
+
+		//! Minimum length of the Environment while some types are retained by time (grows with the number of values of the windows).
+		int _windowHistoricLength;
+
+		//! Lengths of historic declared by the registered Nodes, stored by Node names then by types.
+		map<string, map<string, int> > _declaredLengths;
+
+		//! Lengths of historic declared by the registered Nodes, stored by Node names then by Group ids.
+		map<string, map<string, int> > _declaredGroupLengths;
+
+		//! Maximum length of historic declared for each type.
+		map<string, int> _historicLengths;
+
+		//! Maximum length of historic declared for each Group.
+		map<string, int> _groupHistoricLengths;
+
+		//! Time windows of historic declared by the registered Nodes, stored by Node names then by types.
+		map<string, map<string, int> > _declaredWindows;
+
+		//! Time windows of historic set on the Scheduler, stored by types.
+		map<string, int> _windowPolicies;
+
+		//! Lengths of historic set on the Scheduler, stored by types.
+		map<string, int> _lengthPolicies;
+
+		//! Maximum time window of historic for each type.
+		map<string, int> _historicWindows;
+
+		//! Empty statistics copied for each HistoricTemplate of a type with enabled statistics, stored by types.
+		map<string, HistoricStatistics> _statisticsTypes;
+
+		//! Counters of the work done.
+		SchedulerMetrics _metrics;
+
+		//! Time informations : for getting current time.
+		Timer _timer;
+
+		//! Store the current time.
+		int _timestamp;
+
+		//! Information whether the Scheduler has started.
+		bool _started;
+
+		//! Information whether the Nodes are started by the Scheduler, concurrently by dependency level (instead of by Environment::start)
+		bool _parallelStart;
+
+		//! Nodes started by the Scheduler (stopped by it)
+		vector<Node*> _startedNodes;
+
+		//! Nodes registered by the name of their NodeFactory entry, created once one of their inputs is held by a Group
+		vector<LazyNode> _lazyNodes;
+
+		//! Nodes created by the Scheduler from the NodeFactory (deleted by it)
+		vector<Node*> _createdNodes;
+
+		//! Unique names of the Nodes cloned per Group
+		set<string> _shardedNodes;
+
+		//! Clones of the sharded Nodes, stored by unique names of the Nodes then by ids of Groups
+		map<string, map<string, Node*> > _shards;
+
+		//! Pool of threads updating the clones of a sharded Node, NULL for updating them one after the other
+		ThreadPool* _shardPool;
+
+		//! String for returning error message (updated by all scheduler functions)
+		string _error;
+
+		// Register a Node in the Environment under the given (or a new) unique name and priority, then add it to the graph and the schedule
+		bool addNode(string uniqueName,Node* node,int priority);
+
+		// Add a registered Node to the graph and the schedule, and record the historic lengths it declares
+		void addToGraph(const string& uniqueName,Node* node,int priority);
+
+		// Get the first free priority (the one the Environment gives)
+		int getFreePriority() const;
+
+		// Compute the maximum length and time window of historic of each type and Group, and the length of the Environment
+		void updateHistoricLengths();
+
+		// Get the maximum length declared for a type or a Group, -1 if none
+		int getDeclaredHistoricLength(const string& groupID,const string& type) const;
+
+		// Trim an HistoricTemplate to its time window or to its length
+		template <typename H> void trimHistoric(const string& groupID,H* historic);
+
+		// Get the bit of a type in the presence bitmap, giving it one if needed
+		size_t getTypeBit(const string& type);
+
+		// Count an HistoricTemplate added (1) or removed (-1) for the type of the given bit
+		void countType(size_t bit,int count);
+
+		// Check if one of the inputs of a Node is held by a Group
+		bool hasInputs(const ScheduledNode& scheduled) const;
+
+		// Rebuild the ordered list of Nodes from the priorities of the Environment
+		void buildSchedule();
+
+		// Fill the description of a Node in the schedule from its types
+		void describeNode(const string& uniqueName,Node* node,int priority,ScheduledNode& scheduled);
+
+		// Insert (or remove) a single Node in the schedule at its priority, and update the fused chains and the sub schedules around it
+		void insertScheduledNode(const string& uniqueName,Node* node,int priority);
+		void removeScheduledNode(const string& uniqueName,int priority);
+
+		// Recompute the fused chains from the chain before a position, until the pairs of Nodes are the same as before (from stable on)
+		// and do not fuse, then move the positions of the following chains
+		void updateChains(size_t position,size_t stable,int shift);
+
+		// Get the positions in the schedule of a Generator and of the Nodes reachable from it
+		const vector<size_t>& getSubSchedule(const string& generatorName);
+
+		// Update the Nodes at the given positions of the schedule (all Nodes if NULL)
+		bool runSchedule(const vector<size_t>* positions);
+
+		// Update one Node, return false if it failed after all the tries
+		bool updateNode(ScheduledNode& scheduled);
+
+		// Record the modifications done on the given types, in the given channels, by the last updated Node
+		void refreshStates(const set<string>& types,int channels);
+
+		// Bring back in the stored Groups the Groups added by a Node in the empty maps of its unused channels, return false if there was none
+		bool reclaimEmptyChannels();
+
+		// Forget a removed Group in the Nodes keeping a state by Group (only the 3D Groups are filtered)
+		template <typename G> void forgetGroup(const map<string,G*>& /*groups*/,const string& /*groupID*/) {}
+		void forgetGroup(const map<string,Group3D*>& groups,const string& groupID);
+
+		// Record the modifications of the HistoricTemplate of the given types (all types if empty) with the given epoch, trimming the modified ones
+		template <typename H> void refreshGroupStates(map<string,GroupTemplate<H>*>& groups,GroupSlots<GroupTemplate<H> >& slots,const set<string>& types,unsigned long epoch);
+
+		// Remove the slot of a Group which is no longer stored
+		template <typename G> void removeGroupSlot(const map<string,G*>& groups,GroupSlots<G>& slots,const GroupHandle& handle);
+
+		// Select the Groups to deliver to a Node : modified since its last update (if dirty tracking is enabled) and not stale
+		template <typename H> void selectGroups(map<string,GroupTemplate<H>*>& groups,GroupSlots<GroupTemplate<H> >& slots,const ScheduledNode& scheduled,map<string,GroupTemplate<H>*>& selected);
+
+		// State of a Group of a dimension (0 : Switch, 1 : 1D, 2 : 2D, 3 : 3D), NULL if the Group has no slot
+		const GroupState* getGroupState(int dimension,const string& groupID) const;
+		template <typename G> static const GroupState* getGroupState(const GroupSlots<G>& slots,const string& groupID);
+
+		// Forget the statistics of a type in the Groups of a dimension
+		template <typename G> static void eraseStatistics(GroupSlots<G>& slots,const string& type);
+
+		// Slots of the dimension of a Group type
+		inline const GroupSlots<GroupSwitch>& getGroupSlots(const GroupSwitch*) const {return _slotsSwitch;}
+		inline const GroupSlots<Group1D>& getGroupSlots(const Group1D*) const {return _slots1D;}
+		inline const GroupSlots<Group2D>& getGroupSlots(const Group2D*) const {return _slots2D;}
+		inline const GroupSlots<Group3D>& getGroupSlots(const Group3D*) const {return _slots3D;}
+
+		// Update a Node (or its fused chain) with the given Groups
+		bool runNode(ScheduledNode& scheduled,map<string,Group3D*>& groups3D,map<string,Group2D*>& groups2D,map<string,Group1D*>& groups1D,map<string,GroupSwitch*>& groupsSwitch);
+
+		// Group the registered Nodes by dependency level : a Node comes after all the Nodes producing its inputs (the Nodes of a cycle come last)
+		vector<vector<Node*> > getStartLevels() const;
+
+		// Start (or stop) the given Nodes concurrently, add the names of the failed ones to failed
+		void runConcurrently(const vector<Node*>& nodes,bool starting,string& failed);
+
+		// Create, register and start the lazy Nodes of which one input is held by a Group, return false if one of them failed
+		bool instantiateLazyNodes();
+
+		// Update the clones of a sharded Node, each one with the Groups of its id
+		bool updateShards(ScheduledNode& scheduled);
+
+		// Stop and delete the clones of a sharded Node : all of them, or those of the Groups no longer stored
+		void removeShards(const string& uniqueName,bool all);
+
+		// Update a Node with the given Groups, retrying if needed
+		bool tryUpdate(Node* node,map<string,Group3D*>& groups3D,map<string,Group2D*>& groups2D,map<string,Group1D*>& groups1D,map<string,GroupSwitch*>& groupsSwitch);
+
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param[in] environment : the Environment in which the Nodes will be registered
+		 */
+		Scheduler(Environment* environment);
+
+		/*!
+		 * \brief Destructor
+		 */
+		~Scheduler(void);
+
+		/*!
+		 * \brief Get the Environment in which the Nodes are registered
+		 * \return The Environment of this Scheduler
+		 */
+		inline Environment* getEnvironment() const {return _environment;}
+
+		/*!
+		 * \brief Register a new Node (see Environment::registerNode(Node*))
+		 * As the Environment does, the unique name is made from the name of the Node and a number (name-0, name-1000 ...),
+		 * and the priority is the first free one. The Node is inserted in the schedule without rebuilding it.
+		 * \param[in] node : a pointer to the Node to register
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool registerNode(Node* node);
+
+		/*!
+		 * \brief Register a new Node with its priority (see Environment::registerNode(Node*,int))
+		 * \param[in] node : a pointer to the Node to register
+		 * \param[in] priority : the wanted priority for this node (0 is fully prioritary, 1 is less prioritary ...)
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool registerNode(Node* node,int priority);
+
+		/*!
+		 * \brief Register a new Node with its name (see Environment::registerNode(string,Node*))
+		 * \param[in] uniqueName : a name for this Node (must be unique)
+		 * \param[in] node : a pointer to the Node to register
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool registerNode(string uniqueName,Node* node);
+
+		/*!
+		 * \brief Register a new Node with its unique name and its priority (see Environment::registerNode(string,Node*,int))
+		 * \param[in] uniqueName : a name for this Node (must be unique)
+		 * \param[in] node : a pointer to the Node to register
+		 * \param[in] priority : the wanted priority for this Node (0 is fully prioritary, 1 is less prioritary ...)
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool registerNode(string uniqueName,Node* node,int priority);
+
+		/*!
+		 * \brief Unregister a Node by passing the pointer used to register it
+		 * \param[in] node : the pointer used to register the node
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool unregisterNode(Node* node);
+
+		/*!
+		 * \brief Unregister a Node by passing its name
+		 * The Node is removed from the schedule without rebuilding it.
+		 * \param[in] uniqueName : the name of the Node to unregister
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool unregisterNode(string uniqueName);
+
+		/*!
+		 * \brief Get the unique name given by the Environment to a registered Node
+		 * \param[in] node : the pointer used to register the node
+		 * \return The unique name of the Node, an empty string if it has not been registered through this Scheduler
+		 */
+		string getUniqueName(Node* node) const;
+
+		/*!
+		 * \brief Create a Node from the NodeFactory and register it
+		 * The Node is deleted by the Scheduler.
+		 * \param[in] genericNodeName : the name of the Node in the NodeFactory
+		 * \param[in] uniqueName : a name for this Node (must be unique), empty for a name given by the Environment
+		 * \param[in] priority : the priority of the Node, -1 for the first free priority
+		 * \return The registered Node, NULL if it cannot be created or registered (use getLastError() for getting the problem)
+		 */
+		Node* createNode(string genericNodeName,string uniqueName = "",int priority = -1);
+
+		/*!
+		 * \brief Register a Node created from the NodeFactory once one of its inputs is held by a Group
+		 * The Node is created, registered and started during the first update in which one of the inputs is present, and runs from the next update.
+		 * Until then, it costs nothing at startup. The Node is deleted by the Scheduler.
+		 * As it is not in the CompatibilityGraph before being created, checkCompatibility does not check it.
+		 * \param[in] genericNodeName : the name of the Node in the NodeFactory (see NodeFactory::registerNodesFromConfig)
+		 * \param[in] inputs : the types needed by the Node
+		 * \param[in] priority : the priority of the Node, -1 for the first free priority
+		 * \return true if success, false if the Node is not registered in the NodeFactory
+		 */
+		bool registerLazyNode(string genericNodeName,set<string> inputs,int priority = -1);
+
+		/*!
+		 * \brief Get the number of lazy Nodes not created yet
+		 * \return Number of lazy Nodes waiting for their inputs
+		 */
+		inline size_t getLazyNodeCount() const {return _lazyNodes.size();}
+
+		/*!
+		 * \brief Start the Environment (see Environment::start) and the time of the Scheduler
+		 * With the parallel start option, the Scheduler starts the Nodes itself (see enableParallelStart).
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool start();
+
+		/*!
+		 * \brief Stop the Environment (see Environment::stop), and the Nodes started by the Scheduler
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool stop();
+
+		/*!
+		 * \brief Update the registered Nodes ordered by their priorities
+		 * Generators are always updated. Processors and Observers only receive the Groups in which their inputs changed since their last update.
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool update();
+
+		/*!
+		 * \brief Update a Generator which has new samples and the Nodes reachable from it (event-driven update)
+		 * The other Nodes are not updated. Can be called from the thread of the source, calls are serialized.
+		 * \param[in] generatorName : the unique name of the Generator
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool update(string generatorName);
+
+		/*!
+		 * \brief Update a Generator which has new samples and the Nodes reachable from it (event-driven update)
+		 * \param[in] generator : the pointer used to register the Generator
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool update(Node* generator);
+
+		/*!
+		 * \brief Get the current timestamp of the Scheduler (given to the Nodes during update)
+		 * \return current timestamp
+		 */
+		inline int getTime() const {return _timestamp;}
+
+		/*!
+		 * \brief Get the current epoch (incremented before each Node update)
+		 * \return current epoch
+		 */
+		inline unsigned long getEpoch() const {return _epoch;}
+
+		/*!
+		 * \brief Get the epoch of the last modification of a Group (of any dimension)
+		 * \param[in] groupID : the id of the Group
+		 * \return The epoch of the last modification, 0 if the Group is unknown
+		 */
+		unsigned long getGroupEpoch(string groupID) const;
+
+		/*!
+		 * \brief Get the epoch of the last modification of a type in a Group
+		 * \param[in] groupID : the id of the Group
+		 * \param[in] type : the type of the HistoricTemplate
+		 * \return The epoch of the last modification, 0 if the Group or the type is unknown
+		 */
+		unsigned long getTypeEpoch(string groupID,string type) const;
+
+		/*!
+		 * \brief Get the number of times the last value of an HistoricTemplate has been rewritten in place
+		 * \param[in] groupID : the id of its Group (of any dimension)
+		 * \param[in] historicID : its id in the Group
+		 * \return The version of the last value, 0 if it has not been rewritten (or if the HistoricTemplate is unknown)
+		 */
+		unsigned long getVersion(string groupID,string historicID) const;
+
+		/*!
+		 * \brief Get the state of the dirty tracking option.
+		 * When enabled, Processors and Observers only receive the Groups in which their inputs changed.
+		 * \return Value of the option.
+		 */
+		inline bool dirtyTrackingEnabled() const {return _dirtyTracking;}
+
+		/*!
+		 * \brief Enable/disable the dirty tracking option (disabled by default).
+		 * When enabled, Processors and Observers only receive the Groups in which their inputs changed,
+		 * and are not updated at all when none changed (unless they have a freshness budget).
+		 * \param[in] enabled : the new state of the option
+		 */
+		inline void enableDirtyTracking(bool enabled) {_dirtyTracking = enabled;}
+
+		/*!
+		 * \brief Get the state of the processor fusion option.
+		 * When enabled, consecutive in place FilterProcessors on the same types run in a single pass.
+		 * \return Value of the option.
+		 */
+		inline bool processorFusionEnabled() const {return _fusion;}
+
+		/*!
+		 * \brief Enable/disable the processor fusion option (enabled by default).
+		 * When enabled, consecutive in place FilterProcessors on the same types run in a single pass.
+		 * \param[in] enabled : the new state of the option
+		 */
+		void enableProcessorFusion(bool enabled);
+
+		/*!
+		 * \brief Get the state of the input skipping option.
+		 * When enabled, Processors and Observers are not updated while none of their inputs is held by a Group.
+		 * \return Value of the option.
+		 */
+		inline bool inputSkippingEnabled() const {return _inputSkipping;}
+
+		/*!
+		 * \brief Enable/disable the input skipping option (disabled by default).
+		 * When enabled, Processors and Observers are not updated while none of their needed or consumed types is held by a Group (see isTypePresent).
+		 * The presence of a type is only recorded after the Nodes declaring it in produce() or consume() : a Node writing a type it does not
+		 * declare would leave the Nodes needing this type skipped, so the option must only be enabled with Nodes declaring all their outputs.
+		 * \param[in] enabled : the new state of the option
+		 */
+		inline void enableInputSkipping(bool enabled) {_inputSkipping = enabled;}
+
+		/*!
+		 * \brief Get the state of the parallel start option.
+		 * When enabled, start() starts the Nodes itself, by dependency level, the Nodes of a level being started concurrently.
+		 * \return Value of the option.
+		 */
+		inline bool parallelStartEnabled() const {return _parallelStart;}
+
+		/*!
+		 * \brief Enable/disable the parallel start option (disabled by default).
+		 * When enabled, start() starts the Nodes itself instead of Environment::start : the Generators first, then the Nodes they feed,
+		 * level by level, the Nodes of a level concurrently, each one tried Environment::getTryNumber() times.
+		 * The start function of the Nodes must then be thread-safe. The Environment itself is not started (only the Scheduler updates it),
+		 * so Nodes can be registered at runtime without Environment::enableRuntimeChanges.
+		 * \param[in] enabled : the new state of the option
+		 */
+		inline void enableParallelStart(bool enabled) {_parallelStart = enabled;}
+
+		/*!
+		 * \brief Check if a type is held by at least one Group
+		 * \param[in] type : the type of HistoricTemplate
+		 * \return true if at least one HistoricTemplate of this type is stored
+		 */
+		bool isTypePresent(string type) const;
+
+		/*!
+		 * \brief Get the channels used by a set of types, from their prefixes
+		 * \param[in] types : the types (LG_ORIENTEDPOINT3D_HEAD, LG_SWITCH_KEY_ENTER ...)
+		 * \return The channels (LG_CHANNEL_3D | LG_CHANNEL_SWITCH ...), LG_CHANNEL_ALL if there is no type or an unknown prefix
+		 */
+		static int getChannelsOfTypes(const set<string>& types);
+
+		/*!
+		 * \brief Declare the channels used by a registered Node (instead of deducing them from its types)
+		 * \param[in] node : the pointer used to register the Node
+		 * \param[in] channels : the channels (LG_CHANNEL_3D | LG_CHANNEL_1D ...), negative for deducing them again from its types
+		 */
+		void setChannels(Node* node,int channels);
+
+		/*!
+		 * \brief Get the channels given to a registered Node
+		 * \param[in] node : the pointer used to register the Node
+		 * \return The channels (LG_CHANNEL_3D | LG_CHANNEL_1D ...), 0 if the Node is not registered through this Scheduler
+		 */
+		int getChannels(Node* node);
+
+		/*!
+		 * \brief Clone a registered Processor or Observer per Group (disabled by default)
+		 * The registered Node is only used as a model : for each Group it receives, a clone is created (see Node::clone), started,
+		 * and updated only with the Groups of this id (in all the channels). A stateful filter then keeps a state per user without
+		 * sharing anything between the users. The Groups filtered out by the Node (see Processor::isProcessedGroup and Observer::isObservedGroup)
+		 * get no clone. The clone of a Group is stopped and deleted when the Group is removed, or when the Scheduler stops.
+		 * \param[in] node : the registered Node
+		 * \param[in] sharded : true for cloning the Node per Group, false for updating the Node itself (the clones are deleted)
+		 * \return true if success, false if the Node is not a registered Processor or Observer (use getLastError() for getting the problem)
+		 */
+		bool setSharded(Node* node,bool sharded);
+
+		/*!
+		 * \brief Get the number of clones of a sharded Node
+		 * \param[in] node : the registered Node
+		 * \return The number of Groups for which the Node has a clone
+		 */
+		size_t getShardCount(Node* node) const;
+
+		/*!
+		 * \brief Set the number of threads updating the clones of the sharded Nodes (1 by default)
+		 * With several threads, the clones of a sharded Node are updated concurrently on a work-stealing pool (see ThreadPool),
+		 * the thread updating the Scheduler being one of them : six users tracked by a sharded filter then use six cores.
+		 * A clone only reads and writes the Groups of its id, but its update function must not share unprotected data with the other clones.
+		 * The clones are still created, started and merged back in the Groups by the thread updating the Scheduler.
+		 * \param[in] threadNumber : the number of threads, 0 for one per core, 1 for updating the clones one after the other
+		 */
+		void setShardThreads(size_t threadNumber);
+
+		/*!
+		 * \brief Get the number of threads updating the clones of the sharded Nodes
+		 * \return The number of threads, including the thread updating the Scheduler
+		 */
+		inline size_t getShardThreads() const {return (_shardPool == 0) ? 1 : _shardPool->getThreadNumber();}
+
+		/*!
+		 * \brief Set the freshness budget of a type
+		 * Groups in which the last value of this type is older than the budget are not delivered to the Nodes needing it.
+		 * \param[in] type : the type of HistoricTemplate
+		 * \param[in] maxAge : the maximum age of the last value (same unit as getTime()), negative for removing the budget
+		 */
+		void setFreshnessBudget(string type,int maxAge);
+
+		/*!
+		 * \brief Set the same freshness budget to all the types produced by a Generator
+		 * \param[in] generator : the pointer used to register the Generator
+		 * \param[in] maxAge : the maximum age of the last values (same unit as getTime()), negative for removing the budgets
+		 */
+		void setFreshnessBudget(Node* generator,int maxAge);
+
+		/*!
+		 * \brief Get the freshness budget of a type
+		 * \param[in] type : the type of HistoricTemplate
+		 * \return The maximum age of the last value, -1 if the type has no budget
+		 */
+		int getFreshnessBudget(string type) const;
+
+		/*!
+		 * \brief Set the number of values kept by the HistoricTemplate whose type and Group have no declared length
+		 * \param[in] length : the default length of historic (LG_ENV_HISTORIC_LENGTH_SHORT, LG_ENV_HISTORIC_LENGTH_NORMAL, LG_ENV_HISTORIC_LENGTH_LONG or any positive value)
+		 */
+		void setDefaultHistoricLength(int length);
+
+		/*!
+		 * \brief Get the number of values kept by the HistoricTemplate whose type and Group have no declared length
+		 * \return The default length of historic (the length of the Environment when the Scheduler has been created)
+		 */
+		inline int getDefaultHistoricLength() const {return _defaultHistoricLength;}
+
+		/*!
+		 * \brief Get the number of values kept by an HistoricTemplate
+		 * \param[in] groupID : the id of its Group
+		 * \param[in] type : its type
+		 * \return The maximum length declared for the type or the Group by the registered Nodes (or set with setHistoricLength), the default length if none
+		 */
+		int getHistoricLength(const string& groupID,const string& type) const;
+
+		/*!
+		 * \brief Set the number of values kept by the HistoricTemplate of a type
+		 * If registered Nodes declare a length for the same type (see HistoricRequirement), the longest length is kept.
+		 * \param[in] type : the type of HistoricTemplate
+		 * \param[in] length : the number of values, negative for removing the length
+		 */
+		void setHistoricLength(string type,int length);
+
+		/*!
+		 * \brief Retain the values of a type by time instead of by number
+		 * The values older than the window (compared to the current time of the Scheduler) are removed, the last value is always kept.
+		 * The length of the Environment starts at LG_HISTORIC_WINDOW_LENGTH values and is doubled whenever the window holds more than half of it
+		 * (a window found full is counted in SchedulerMetrics::truncatedWindows).
+		 * If registered Nodes declare a window for the same type (see HistoricRequirement), the longest window is kept.
+		 * \param[in] type : the type of HistoricTemplate
+		 * \param[in] window : the time during which the values are kept (same unit as getTime()), negative for removing the window
+		 */
+		void setHistoricWindow(string type,int window);
+
+		/*!
+		 * \brief Get the time window of a type
+		 * \param[in] type : the type of HistoricTemplate
+		 * \return The time during which the values are kept (same unit as getTime()), -1 if the type is retained by number
+		 */
+		int getHistoricWindow(string type) const;
+
+		/*!
+		 * \brief Enable incremental statistics on the HistoricTemplate of a type
+		 * The statistics are updated with the new values each time a Generator or a Processor modifies the type.
+		 * \param[in] type : the type of HistoricTemplate
+		 * \param[in] window : the number of values on which sum, mean, variance, minimum and maximum are computed
+		 * \param[in] smoothing : the weight of a new value in the exponentially weighted average (between 0.0 and 1.0)
+		 */
+		void enableStatistics(string type,int window = 32,float smoothing = 0.1f);
+
+		/*!
+		 * \brief Disable the statistics of a type and remove the computed ones
+		 * \param[in] type : the type of HistoricTemplate
+		 */
+		void disableStatistics(string type);
+
+		/*!
+		 * \brief Get the statistics of an HistoricTemplate
+		 * \param[in] groupID : the id of its Group (of any dimension)
+		 * \param[in] historicID : its id in the Group
+		 * \return The statistics, NULL if the Group or the HistoricTemplate is unknown or if its type has no enabled statistics
+		 */
+		const HistoricStatistics* getStatistics(string groupID,string historicID) const;
+
+		/*!
+		 * \brief Get the counters of the work done by the Scheduler
+		 * \return The metrics of the Scheduler
+		 */
+		inline SchedulerMetrics getMetrics() const {return _metrics;}
+
+		/*!
+		 * \brief Reset the counters of the work done by the Scheduler
+		 */
+		inline void resetMetrics() {_metrics = SchedulerMetrics();}
+
+		/*!
+		 * \brief Get the Switch Groups at their current state
+		 * \return the map of the Switch groups
+		 */
+		inline const map<string, GroupSwitch*>& getGroupsSwitch() const {return _groupsSwitch;}
+
+		/*!
+		 * \brief Get the 1D Groups at their current state
+		 * \return the map of the 1D groups
+		 */
+		inline const map<string, Group1D*>& getGroups1D() const {return _groups1D;}
+
+		/*!
+		 * \brief Get the 2D Groups at their current state
+		 * \return the map of the 2D groups
+		 */
+		inline const map<string, Group2D*>& getGroups2D() const {return _groups2D;}
+
+		/*!
+		 * \brief Get the 3D Groups at their current state
+		 * \return the map of the 3D groups
+		 */
+		inline const map<string, Group3D*>& getGroups3D() const {return _groups3D;}
+
+		/*!
+		 * \brief Get the handle of a stored Group, G being GroupSwitch, Group1D, Group2D or Group3D
+		 * Handles are given to the Groups when the Scheduler records their state (after each update) and stay valid until the Group is removed,
+		 * whatever the other additions and removals.
+		 * \param[in] groupID : id of the Group
+		 * \return The handle, a default (unset) handle if the Group has no handle
+		 */
+		template <typename G> GroupHandle findGroup(const string& groupID) const
+		{
+			return getGroupSlots((const G*)0).slots.find(groupID);
+		}
+
+		/*!
+		 * \brief Get a stored Group by its handle, G being GroupSwitch, Group1D, Group2D or Group3D
+		 * \param[in] handle : handle given by findGroup or getGroupHandleAt
+		 * \return The Group, NULL if the handle is invalid (the Group has been removed)
+		 */
+		template <typename G> G* getGroup(const GroupHandle& handle) const
+		{
+			const GroupSlot<G>* slot = getGroupSlots((const G*)0).slots.get(handle);
+			return (slot == 0) ? 0 : slot->group;
+		}
+
+		/*!
+		 * \brief Get the number of Groups having a handle, G being GroupSwitch, Group1D, Group2D or Group3D
+		 * \return Number of Groups, the positions of getGroupAt, getGroupHandleAt and getGroupIDAt are between 0 and this number - 1
+		 */
+		template <typename G> size_t getGroupCount() const
+		{
+			return getGroupSlots((const G*)0).slots.size();
+		}
+
+		/*!
+		 * \brief Get a Group by its position in the dense array of its dimension (for walking all the Groups without looking up their ids)
+		 * Positions change when a Group is removed, handles do not.
+		 * \param[in] position : between 0 and getGroupCount<G>() - 1
+		 * \return The Group
+		 */
+		template <typename G> G* getGroupAt(size_t position) const
+		{
+			return getGroupSlots((const G*)0).slots.at(position).group;
+		}
+
+		/*!
+		 * \brief Get the handle of a Group by its position in the dense array of its dimension
+		 * \param[in] position : between 0 and getGroupCount<G>() - 1
+		 * \return The handle of the Group
+		 */
+		template <typename G> GroupHandle getGroupHandleAt(size_t position) const
+		{
+			return getGroupSlots((const G*)0).slots.handleAt(position);
+		}
+
+		/*!
+		 * \brief Get the id of a Group by its position in the dense array of its dimension
+		 * \param[in] position : between 0 and getGroupCount<G>() - 1
+		 * \return The id of the Group
+		 */
+		template <typename G> string getGroupIDAt(size_t position) const
+		{
+			return getGroupSlots((const G*)0).slots.idAt(position);
+		}
+
+		/*!
+		 * \brief Check if the registered Nodes have the data they need for working (produced by Nodes of lower priorities, as Environment::checkCompatibility)
+		 * The CompatibilityGraph is kept up to date at each registration, so this check does not visit the Nodes.
+		 * Cycles of types are only rejected when enabled (see enableCycleRejection).
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool checkCompatibility();
+
+		/*!
+		 * \brief Get the state of the cycle rejection option.
+		 * \return Value of the option.
+		 */
+		inline bool cycleRejectionEnabled() const {return _graph.cycleRejectionEnabled();}
+
+		/*!
+		 * \brief Enable/disable the cycle rejection option (disabled by default).
+		 * When enabled, checkCompatibility also fails when a Node needs a type produced from its own outputs, whatever the priorities
+		 * (see CompatibilityGraph::enableCycleRejection).
+		 * \param[in] enabled : the new state of the option
+		 */
+		inline void enableCycleRejection(bool enabled) {_graph.enableCycleRejection(enabled);}
+
+		/*!
+		 * \brief Check the compatibility of the registered Nodes and order them (done by the first update otherwise)
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool prepare();
+
+		/*!
+		 * \brief Get the graph of the types exchanged by the registered Nodes
+		 * \return The CompatibilityGraph of this Scheduler
+		 */
+		inline const CompatibilityGraph& getCompatibilityGraph() const {return _graph;}
+
+		/*!
+		 * \brief Get the last generated error
+		 * \return a string describing the error
+		 */
+		string getLastError();
+	};
+
+	/*!
+	 * \brief Get the Scheduler created on an Environment (for Nodes reading the statistics or the epochs)
+	 * \param[in] e : the Environment of the Node
+	 * \return The Scheduler of this Environment, NULL if there is none
+	 */
+	extern Scheduler* getSchedulerOfEnvironment(Environment* e);
+}
+
+#endif /* LGSCHEDULER_H_ */
@@ -0,0 +1,369 @@
+#pragma once
+
+/*!
+ * \file LgSharedState.h
+ * \brief File containing the layout of the shared memory written by a SharedStatePublisher, and the SharedStateReader class reading it from
+ * another process. This file only depends on the system : it can be copied in the rendering or UI applications, without libGina.
+ * \version 0.2
+ * \date 19 october 2026
+ */
+
+#ifndef LGSHAREDSTATE_H_
+#define LGSHAREDSTATE_H_
+
+/*!
+* \brief First bytes of a shared memory written by a SharedStatePublisher ("LGSS")
+*/
+#define LG_SHARED_STATE_MAGIC 0x5353474Cu
+
+/*!
+* \brief Version of the layout of the shared memory
+*/
+#define LG_SHARED_STATE_VERSION 1u
+
+/*!
+* \brief Size of the names (ids of Groups, names of Nodes) in the shared memory, ending by '\0' (longer names are cut)
+*/
+#define LG_SHARED_STATE_NAME_SIZE 48
+
+/*!
+* \brief Size of the types of HistoricTemplate in the shared memory, ending by '\0' (longer types are cut)
+*/
+#define LG_SHARED_STATE_TYPE_SIZE 64
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#if defined _WIN32  || defined _WIN64
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/*!
+ * \namespace lg
+ * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
+*/
+namespace lg
+{
+	/*!
+	 * \brief Last value of an HistoricTemplate of a Group
+	*/
+	struct SharedElement
+	{
+		//! Id of the Group
+		char groupID[LG_SHARED_STATE_NAME_SIZE];
+
+		//! Type of the HistoricTemplate (LG_ORIENTEDPOINT3D_RIGHT_HAND ...)
+		char type[LG_SHARED_STATE_TYPE_SIZE];
+
+		//! Dimension of the Group : 3, 2, 1, or 0 for a Switch
+		int32_t dimension;
+
+		//! Timestamp of the value
+		int32_t timestamp;
+
+		//! Position (x, y, z for 3D, x, y for 2D, x for 1D, 1 or 0 for the state of a Switch)
+		float position[3];
+
+		//! Orientation (x, y, z for 3D, angle for 2D, 1 or 0 for 1D)
+		float orientation[3];
+
+		//! Confidence and intensity of the value
+		float confidence;
+		float intensity;
+	};
+
+	/*!
+	 * \brief Probability given by an Observer to a Group
+	*/
+	struct SharedProbability
+	{
+		//! Name of the Observer
+		char nodeName[LG_SHARED_STATE_NAME_SIZE];
+
+		//! Id of the Group
+		char groupID[LG_SHARED_STATE_NAME_SIZE];
+
+		//! Probability that the gesture of the Observer has been recognized
+		float probability;
+	};
+
+	/*!
+	 * \brief Frame of the ring, followed by its SharedElement then its SharedProbability
+	 * The sequence is odd while the frame is written : 2n + 1 while writing the frame n (counted from 0), then 2n + 2.
+	*/
+	struct SharedFrame
+	{
+		//! Sequence of the frame (see above)
+		atomic<uint32_t> sequence;
+
+		//! Timestamp of the Environment
+		int32_t timestamp;
+
+		//! Number of SharedElement and SharedProbability of the frame
+		uint32_t elementCount;
+		uint32_t probabilityCount;
+
+		//! Number of values which did not fit in the frame
+		uint32_t droppedCount;
+	};
+
+	/*!
+	 * \brief Beginning of the shared memory, followed by the frames of the ring
+	*/
+	struct SharedStateHeader
+	{
+		//! LG_SHARED_STATE_MAGIC, written once the header is complete
+		atomic<uint32_t> magic;
+
+		//! LG_SHARED_STATE_VERSION
+		uint32_t version;
+
+		//! Number of frames of the ring, and size of each frame in bytes
+		uint32_t frameCount;
+		uint32_t frameSize;
+
+		//! Maximum number of SharedElement and SharedProbability of a frame
+		uint32_t elementCapacity;
+		uint32_t probabilityCapacity;
+
+		//! Number of frames published (the last one is the frame (published - 1) % frameCount)
+		atomic<uint32_t> published;
+	};
+
+	// The frames are read by other processes, which must see the atomics as plain integers
+	static_assert(sizeof(atomic<uint32_t>) == sizeof(uint32_t),"libGina : atomic<uint32_t> must be a plain 32 bits integer.");
+
+	/*!
+	 * \brief Size of a SharedStateHeader or of a SharedFrame rounded to a cache line, so two frames never share one
+	 * \param[in] size : the size in bytes
+	 * \return The rounded size
+	 */
+	inline size_t getSharedStateAlignedSize(size_t size) {return (size + 63) & ~(size_t)63;}
+
+	/*!
+	 * \brief Get the SharedElement of a frame
+	 * \param[in] frame : the frame
+	 * \return The first SharedElement
+	 */
+	inline const SharedElement* getSharedElements(const SharedFrame* frame)
+	{
+		return reinterpret_cast<const SharedElement*>(reinterpret_cast<const char*>(frame) + getSharedStateAlignedSize(sizeof(SharedFrame)));
+	}
+
+	/*!
+	 * \brief Get the SharedProbability of a frame
+	 * \param[in] frame : the frame
+	 * \param[in] elementCapacity : the maximum number of SharedElement of a frame (see SharedStateHeader)
+	 * \return The first SharedProbability
+	 */
+	inline const SharedProbability* getSharedProbabilities(const SharedFrame* frame,uint32_t elementCapacity)
+	{
+		return reinterpret_cast<const SharedProbability*>(getSharedElements(frame) + elementCapacity);
+	}
+
+	/*!
+	 * \class SharedStateReader
+	 * \brief Reader of the frames published by a SharedStatePublisher, from any process (POSIX systems only).
+	 * The shared memory is mapped once : reading a frame is done in place, without copy and without system call.
+	 * The publisher never waits for the readers (seqlock) : a read is started by beginRead, which gives the last complete frame,
+	 * and must be checked by endRead once the values are used. If the publisher has written the frame again meanwhile
+	 * (the reader was slower than the whole ring), endRead returns false and the values must be ignored.
+	 *
+	 * \code
+	 * SharedStateReader reader;
+	 * reader.open("/libgina");
+	 * uint32_t sequence;
+	 * const SharedFrame* frame = reader.beginRead(sequence);
+	 * if(frame != 0)
+	 * {
+	 *     const SharedElement* elements = getSharedElements(frame);
+	 *     // use elements[0] ... elements[frame->elementCount - 1]
+	 *     if(!reader.endRead(frame,sequence)) ; // overwritten while reading
+	 * }
+	 * \endcode
+	*/
+	class SharedStateReader
+	{
+	private:
+		//! The mapped memory, NULL if not opened
+		const SharedStateHeader* _header;
+
+		//! Size of the mapped memory
+		size_t _size;
+
+		//! Description of the last error
+		string _error;
+
+		// Get a frame of the ring
+		inline const SharedFrame* getFrame(uint32_t index) const
+		{
+			return reinterpret_cast<const SharedFrame*>(reinterpret_cast<const char*>(_header) + getSharedStateAlignedSize(sizeof(SharedStateHeader)) + (size_t)index*_header->frameSize);
+		}
+
+	public:
+		/*!
+		 * \brief Constructor
+		 */
+		SharedStateReader(void) : _header(0),_size(0) {}
+
+		/*!
+		 * \brief Destructor (unmaps the memory)
+		 */
+		~SharedStateReader(void) {close();}
+
+		/*!
+		 * \brief Map the shared memory of a publisher
+		 * \param[in] segmentName : the name of the shared memory given to the SharedStatePublisher ("/libgina" ...)
+		 * \return true if success, false if the memory does not exist or is not written by a publisher (use getLastError() for getting the problem)
+		 */
+		bool open(const string& segmentName)
+		{
+			close();
+#if defined _WIN32  || defined _WIN64
+			_error = "libGina : Error : shared memory is not supported on this system (" + segmentName + ").";
+			return false;
+#else
+			int descriptor = shm_open(segmentName.c_str(),O_RDONLY,0);
+			if(descriptor < 0)
+			{
+				_error = "libGina : Error : cannot open the shared memory " + segmentName + ".";
+				return false;
+			}
+			struct stat status;
+			void* memory = MAP_FAILED;
+			if((fstat(descriptor,&status) == 0)&&((size_t)status.st_size >= sizeof(SharedStateHeader)))
+				memory = mmap(0,(size_t)status.st_size,PROT_READ,MAP_SHARED,descriptor,0);
+			::close(descriptor);
+			if(memory == MAP_FAILED)
+			{
+				_error = "libGina : Error : cannot map the shared memory " + segmentName + ".";
+				return false;
+			}
+
+			// Check the layout before using the sizes it gives
+			const SharedStateHeader* header = static_cast<const SharedStateHeader*>(memory);
+			size_t size = (size_t)status.st_size;
+			if((header->magic.load(memory_order_acquire) != LG_SHARED_STATE_MAGIC)||(header->version != LG_SHARED_STATE_VERSION)||(header->frameCount == 0)
+				||(header->frameSize < getSharedStateAlignedSize(sizeof(SharedFrame)) + header->elementCapacity*sizeof(SharedElement) + header->probabilityCapacity*sizeof(SharedProbability))
+				||(getSharedStateAlignedSize(sizeof(SharedStateHeader)) + (size_t)header->frameCount*header->frameSize > size))
+			{
+				munmap(memory,size);
+				_error = "libGina : Error : " + segmentName + " is not written by a SharedStatePublisher of this version.";
+				return false;
+			}
+			_header = header;
+			_size = size;
+			return true;
+#endif
+		}
+
+		/*!
+		 * \brief Unmap the shared memory
+		 */
+		void close()
+		{
+#if defined _WIN32  || defined _WIN64
+#else
+			if(_header != 0) munmap(const_cast<SharedStateHeader*>(_header),_size);
+#endif
+			_header = 0;
+			_size = 0;
+		}
+
+		/*!
+		 * \brief Check if the shared memory is mapped
+		 * \return true if open has succeeded
+		 */
+		inline bool isOpen() const {return (_header != 0);}
+
+		/*!
+		 * \brief Get the header of the shared memory (capacities of the frames ...)
+		 * \return The header, NULL if not opened
+		 */
+		inline const SharedStateHeader* getHeader() const {return _header;}
+
+		/*!
+		 * \brief Get the number of frames published
+		 * \return The number of frames, 0 if not opened or nothing published yet
+		 */
+		inline uint32_t getPublishedCount() const {return (_header == 0) ? 0 : _header->published.load(memory_order_acquire);}
+
+		/*!
+		 * \brief Start reading the last complete frame
+		 * \param[out] sequence : the sequence of the frame, to give to endRead
+		 * \return The frame (in the shared memory), NULL if nothing has been published
+		 */
+		const SharedFrame* beginRead(uint32_t& sequence) const
+		{
+			if(_header == 0) return 0;
+			while(true)
+			{
+				uint32_t published = _header->published.load(memory_order_acquire);
+				if(published == 0) return 0;
+				const SharedFrame* frame = getFrame((published - 1) % _header->frameCount);
+				sequence = frame->sequence.load(memory_order_acquire);
+
+				// Even : complete, else the ring has turned since (the publisher is writing this frame again), the next one is taken
+				if((sequence & 1u) == 0) return frame;
+			}
+		}
+
+		/*!
+		 * \brief Check that a frame has not been overwritten while reading it
+		 * \param[in] frame : the frame given by beginRead
+		 * \param[in] sequence : the sequence given by beginRead
+		 * \return true if the values read since beginRead are valid
+		 */
+		bool endRead(const SharedFrame* frame,uint32_t sequence) const
+		{
+			atomic_thread_fence(memory_order_acquire);
+			return (frame->sequence.load(memory_order_relaxed) == sequence);
+		}
+
+		/*!
+		 * \brief Copy the last complete frame (for readers keeping the values, beginRead and endRead read them in place)
+		 * \param[out] elements : the values of the Groups
+		 * \param[out] probabilities : the probabilities of the Observers
+		 * \param[out] timestamp : the timestamp of the frame
+		 * \return true if a frame has been copied, false if nothing has been published
+		 */
+		bool copyLastFrame(vector<SharedElement>& elements,vector<SharedProbability>& probabilities,int& timestamp) const
+		{
+			uint32_t sequence;
+			const SharedFrame* frame;
+			do
+			{
+				frame = beginRead(sequence);
+				if(frame == 0) return false;
+				uint32_t elementCount = frame->elementCount;
+				uint32_t probabilityCount = frame->probabilityCount;
+				timestamp = frame->timestamp;
+				if(elementCount > _header->elementCapacity) elementCount = _header->elementCapacity;
+				if(probabilityCount > _header->probabilityCapacity) probabilityCount = _header->probabilityCapacity;
+				elements.assign(getSharedElements(frame),getSharedElements(frame) + elementCount);
+				probabilities.assign(getSharedProbabilities(frame,_header->elementCapacity),getSharedProbabilities(frame,_header->elementCapacity) + probabilityCount);
+			}
+			while(!endRead(frame,sequence));
+			return true;
+		}
+
+		/*!
+		 * \brief Get the last error
+		 * \return A description of the last error
+		 */
+		inline string getLastError() const {return _error;}
+	};
+}
+
+#endif /* LGSHAREDSTATE_H_ */
@@ -0,0 +1,143 @@
+#pragma once
+
+/*!
+ * \file LgSharedStatePublisher.h
+ * \brief File containing the SharedStatePublisher class, an Observer writing the state of the Environment in a shared memory read by other processes.
+ * \version 0.2
+ * \date 19 october 2026
+ */
+
+#ifndef LGSHAREDSTATEPUBLISHER_H_
+#define LGSHAREDSTATEPUBLISHER_H_
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "LgObserver.h"
+#include "LgSharedState.h"
+
+using namespace std;
+
+/*!
+ * \namespace lg
+ * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
+*/
+namespace lg
+{
+	/*!
+	 * \class SharedStatePublisher
+	 * \brief Observer publishing, at each update, the last value of each HistoricTemplate of the observed Groups and the probabilities
+	 * of some Observers in a POSIX shared memory (POSIX systems only, see LgSharedState.h for the layout).
+	 * Rendering or UI processes read it with a SharedStateReader (header only), in place and without system call.
+	 *
+	 * The shared memory is a ring of frames protected by sequences (seqlock) : the publisher never waits for the readers,
+	 * and a reader slower than the whole ring detects that its frame has been overwritten.
+	 * The memory is created by start (with a fixed capacity of values per frame, the other values are counted as dropped) and removed by stop.
+	 * The filters of the Observer (onlyObserveGroupIDs, ignorePointType ...) restrain the published values.
+	 * For publishing the probabilities computed in the same update, the Observers must be updated before the publisher (lower priority).
+	 * Observer::getProbabilities returns a copy : each published Observer costs the copy of its map of probabilities at each update.
+	 * A clone (see Scheduler::setSharded) publishes in its own shared memory, named segmentName-cloneName.
+	*/
+	class SharedStatePublisher : public Observer
+	{
+	private:
+		//! Name of the shared memory ("/libgina" ...)
+		string _segmentName;
+
+		//! Number of frames of the ring
+		uint32_t _frameCount;
+
+		//! Maximum number of values and probabilities of a frame
+		uint32_t _elementCapacity;
+		uint32_t _probabilityCapacity;
+
+		//! Observers whose probabilities are published
+		vector<const Observer*> _probabilityNodes;
+
+		//! The mapped memory, NULL if not started
+		SharedStateHeader* _header;
+
+		//! Size of the mapped memory
+		size_t _size;
+
+		//! Description of the last error
+		string _error;
+
+		// Get a frame of the ring
+		SharedFrame* getFrame(uint32_t index) const;
+
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param[in] name : a name for the instance of this Node
+		 * \param[in] segmentName : the name of the shared memory, starting with '/'
+		 * \param[in] elementCapacity : the maximum number of values of a frame
+		 * \param[in] probabilityCapacity : the maximum number of probabilities of a frame
+		 * \param[in] frameCount : the number of frames of the ring (at least 2), more frames giving more time to slow readers
+		 */
+		SharedStatePublisher(string name,string segmentName = "/libgina",uint32_t elementCapacity = 256,uint32_t probabilityCapacity = 64,uint32_t frameCount = 4);
+
+		/*!
+		 * \brief Destructor (removes the shared memory if still started)
+		 */
+		~SharedStatePublisher(void);
+
+		/*!
+		 * \brief Publish the probabilities of an Observer (under the name of the Observer)
+		 * \param[in] observer : the Observer, which must stay alive while the publisher is updated
+		 */
+		void publishProbabilities(const Observer* observer);
+
+		/*!
+		 * \brief Get the name of the shared memory
+		 * \return The name given to the constructor
+		 */
+		inline string getSegmentName() const {return _segmentName;}
+
+		/*!
+		 * \brief Get the number of frames published since start
+		 * \return The number of frames
+		 */
+		inline uint32_t getPublishedCount() const {return (_header == 0) ? 0 : _header->published.load(memory_order_relaxed);}
+
+		/*!
+		 * \brief Clone the publisher, with its own shared memory (segmentName-cloneName, a '/' in the name of the clone being replaced by '_')
+		 * \param[in] cloneName : the name of the clone
+		 * \return The clone
+		 */
+		Node* clone(string cloneName) const;
+
+		/*!
+		 * \brief Create and map the shared memory (an old memory of the same name is replaced)
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool start();
+
+		/*!
+		 * \brief Unmap and remove the shared memory (mapped readers keep their view of the last frames)
+		 * \return true
+		 */
+		bool stop();
+
+		/*!
+		 * \brief Write a frame with the last values of the Groups and the probabilities of the published Observers
+		 * \return true if success, false if not started
+		 */
+		bool observe(map<string,Group3D*> groups3D,map<string,Group2D*> groups2D,map<string,Group1D*> groups1D,map<string,GroupSwitch*> groupsSwitch);
+
+		/*!
+		 * \brief Return the types needed by the publisher : none, it publishes all the Groups it receives
+		 * \return An empty set
+		 */
+		set<string> need() const {return set<string>();}
+
+		/*!
+		 * \brief Get the last error
+		 * \return A description of the last error
+		 */
+		inline string getLastError() const {return _error;}
+	};
+}
+
+#endif /* LGSHAREDSTATEPUBLISHER_H_ */
@@ -0,0 +1,381 @@
+#pragma once
+
+/*!
+ * \file LgStaticPipeline.h
+ * \brief File containing the StaticPipeline class template, a pipeline of Nodes fixed at compile time.
+ * \version 0.2
+ * \date 19 october 2026
+ */
+
+#ifndef LGSTATICPIPELINE_H_
+#define LGSTATICPIPELINE_H_
+
+/*!
+* \brief Identifier of a type of data computed at compile time (LG_TYPE_ID(LG_ORIENTEDPOINT3D_HEAD) ...)
+*/
+#define LG_TYPE_ID(type) (lg::typeHash(type))
+
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include "LgData.h"
+#include "LgEnvironment.h"
+#include "LgGenerator.h"
+#include "LgObserver.h"
+#include "LgTimer.h"
+
+using namespace std;
+
+/*!
+ * \namespace lg
+ * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
+*/
+namespace lg
+{
+	/*!
+	 * \brief Hash (FNV-1a) of a type of data, computed at compile time for literals
+	 * \param[in] type : the type (LG_ORIENTEDPOINT3D_HEAD ...)
+	 * \param[in] hash : the hash of the previous characters
+	 * \return The identifier of the type
+	 */
+	constexpr unsigned int typeHash(const char* type,unsigned int hash = 2166136261u)
+	{
+		return (*type == 0) ? hash : typeHash(type + 1,(hash ^ (unsigned int)(unsigned char)*type)*16777619u);
+	}
+
+	/*!
+	 * \brief Hash of a type of data at runtime (same value as typeHash on the literal)
+	 * \param[in] type : the type (as returned by HistoricTemplate::getType ...)
+	 * \return The identifier of the type
+	 */
+	inline unsigned int typeHashOf(const string& type)
+	{
+		unsigned int hash = 2166136261u;
+		for(string::const_iterator it = type.begin();it != type.end();it++) hash = (hash ^ (unsigned int)(unsigned char)*it)*16777619u;
+		return hash;
+	}
+
+	/*!
+	 * \brief List of type identifiers known at compile time.
+	 * A Node used in a StaticPipeline can declare "typedef TypeIDs<LG_TYPE_ID(...),...> StaticNeed;" and "typedef TypeIDs<...> StaticProduce;",
+	 * the pipeline then checks at compile time that every needed type is produced by a previous Node, and checks at start that these
+	 * declarations match the types returned by need, consume and produce (by comparing their identifiers).
+	*/
+	template <unsigned int... IDs> struct TypeIDs {};
+
+	// Compile time helpers of StaticPipeline
+	namespace pipeline
+	{
+		template <typename T> struct VoidOf {typedef void type;};
+
+		template <typename A,typename B> struct Concat;
+		template <unsigned int... A,unsigned int... B> struct Concat<TypeIDs<A...>,TypeIDs<B...> > {typedef TypeIDs<A...,B...> type;};
+
+		template <unsigned int ID,typename List> struct Contains {static const bool value = false;};
+		template <unsigned int ID,unsigned int First,unsigned int... Rest> struct Contains<ID,TypeIDs<First,Rest...> > {static const bool value = (ID == First)||Contains<ID,TypeIDs<Rest...> >::value;};
+
+		template <typename Needed,typename Produced> struct Included {static const bool value = true;};
+		template <unsigned int First,unsigned int... Rest,typename Produced> struct Included<TypeIDs<First,Rest...>,Produced> {static const bool value = Contains<First,Produced>::value && Included<TypeIDs<Rest...>,Produced>::value;};
+
+		template <typename T,typename = void> struct NeedOf {typedef TypeIDs<> type;};
+		template <typename T> struct NeedOf<T,typename VoidOf<typename T::StaticNeed>::type> {typedef typename T::StaticNeed type;};
+
+		template <typename T,typename = void> struct ProduceOf {typedef TypeIDs<> type;};
+		template <typename T> struct ProduceOf<T,typename VoidOf<typename T::StaticProduce>::type> {typedef typename T::StaticProduce type;};
+
+		template <typename T,typename = void> struct DeclaresNeed {static const bool value = false;};
+		template <typename T> struct DeclaresNeed<T,typename VoidOf<typename T::StaticNeed>::type> {static const bool value = true;};
+
+		template <typename T,typename = void> struct DeclaresProduce {static const bool value = false;};
+		template <typename T> struct DeclaresProduce<T,typename VoidOf<typename T::StaticProduce>::type> {static const bool value = true;};
+
+		// Identifiers of a list, at runtime
+		template <typename List> struct Values;
+		template <unsigned int... IDs> struct Values<TypeIDs<IDs...> >
+		{
+			static set<unsigned int> get()
+			{
+				unsigned int ids[] = {IDs...,0u};
+				return set<unsigned int>(ids,ids + sizeof...(IDs));
+			}
+		};
+
+		// Check that the identifiers of some types are all in a list
+		inline bool identified(const set<string>& types,const set<unsigned int>& ids,string& missing)
+		{
+			for(set<string>::const_iterator it = types.begin();it != types.end();it++)
+			{
+				if(ids.count(typeHashOf(*it))) continue;
+				missing = *it;
+				return false;
+			}
+			return true;
+		}
+
+		// Every Node finds its needed types in the types produced by the previous ones
+		template <typename Produced,typename... Nodes> struct Satisfied {static const bool value = true;};
+		template <typename Produced,typename First,typename... Rest> struct Satisfied<Produced,First,Rest...>
+		{
+			static const bool value = Included<typename NeedOf<First>::type,Produced>::value && Satisfied<typename Concat<Produced,typename ProduceOf<First>::type>::type,Rest...>::value;
+		};
+
+		// Main function of a Node, qualified by its exact class : a Processor implements update itself
+		template <typename T,bool IsGenerator = is_base_of<Generator,T>::value,bool IsObserver = is_base_of<Observer,T>::value> struct Call
+		{
+			static bool update(T& node,bool /*dataCopy*/,map<string,Group3D*>& groups3D,map<string,Group2D*>& groups2D,map<string,Group1D*>& groups1D,map<string,GroupSwitch*>& groupsSwitch)
+			{
+				return node.T::update(groups3D,groups2D,groups1D,groupsSwitch);
+			}
+		};
+
+		// Generator::update only adds the Data Copy option around generate
+		template <typename T> struct Call<T,true,false>
+		{
+			static bool update(T& node,bool dataCopy,map<string,Group3D*>& groups3D,map<string,Group2D*>& groups2D,map<string,Group1D*>& groups1D,map<string,GroupSwitch*>& groupsSwitch)
+			{
+				if(dataCopy) return node.Generator::update(groups3D,groups2D,groups1D,groupsSwitch);
+				return node.T::generate(groups3D,groups2D,groups1D,groupsSwitch);
+			}
+		};
+
+		// Observer::update only adds the Data Copy option around observe (which takes the maps by value)
+		template <typename T> struct Call<T,false,true>
+		{
+			static bool update(T& node,bool dataCopy,map<string,Group3D*>& groups3D,map<string,Group2D*>& groups2D,map<string,Group1D*>& groups1D,map<string,GroupSwitch*>& groupsSwitch)
+			{
+				if(dataCopy) return node.Observer::update(groups3D,groups2D,groups1D,groupsSwitch);
+				return node.T::observe(groups3D,groups2D,groups1D,groupsSwitch);
+			}
+		};
+
+		// Calls on each Node of the tuple, resolved at compile time (no virtual dispatch)
+		template <size_t I,size_t N> struct Step
+		{
+			template <typename Tuple> static void setup(Tuple& nodes,Environment* environment)
+			{
+				get<I>(nodes).setEnvironment(environment);
+				get<I>(nodes).setID((int)I + 1);
+				Step<I + 1,N>::setup(nodes,environment);
+			}
+
+			template <typename Tuple> static bool start(Tuple& nodes)
+			{
+				typedef typename tuple_element<I,Tuple>::type T;
+				return get<I>(nodes).T::start() && Step<I + 1,N>::start(nodes);
+			}
+
+			// The needed and consumed types must be declared in StaticNeed, the declared produced types must be produced
+			template <typename Tuple> static bool check(Tuple& nodes,string& error)
+			{
+				typedef typename tuple_element<I,Tuple>::type T;
+				T& node = get<I>(nodes);
+				string type;
+				if(DeclaresNeed<T>::value)
+				{
+					set<string> inputs = node.need();
+					set<string> consumed = node.consume();
+					inputs.insert(consumed.begin(),consumed.end());
+					if(!identified(inputs,Values<typename NeedOf<T>::type>::get(),type))
+					{
+						error = "libGina : Error : " + node.getName() + " node needs " + type + " which is not in its StaticNeed.";
+						return false;
+					}
+				}
+				if(DeclaresProduce<T>::value)
+				{
+					set<string> outputs = node.produce();
+					set<unsigned int> produced;
+					for(set<string>::iterator it = outputs.begin();it != outputs.end();it++) produced.insert(typeHashOf(*it));
+					set<unsigned int> declared = Values<typename ProduceOf<T>::type>::get();
+					for(set<unsigned int>::iterator it = declared.begin();it != declared.end();it++)
+					{
+						if(produced.count(*it)) continue;
+						error = "libGina : Error : " + node.getName() + " node does not produce a type of its StaticProduce.";
+						return false;
+					}
+				}
+				return Step<I + 1,N>::check(nodes,error);
+			}
+
+			template <typename Tuple> static bool stop(Tuple& nodes)
+			{
+				typedef typename tuple_element<I,Tuple>::type T;
+				bool success = get<I>(nodes).T::stop();
+				return Step<I + 1,N>::stop(nodes) && success;
+			}
+
+			template <typename Tuple> static bool update(Tuple& nodes,int timestamp,bool dataCopy,map<string,Group3D*>& groups3D,map<string,Group2D*>& groups2D,map<string,Group1D*>& groups1D,map<string,GroupSwitch*>& groupsSwitch)
+			{
+				typedef typename tuple_element<I,Tuple>::type T;
+				T& node = get<I>(nodes);
+				node.updateTime(timestamp);
+				bool success = Call<T>::update(node,dataCopy,groups3D,groups2D,groups1D,groupsSwitch);
+				return Step<I + 1,N>::update(nodes,timestamp,dataCopy,groups3D,groups2D,groups1D,groupsSwitch) && success;
+			}
+		};
+
+		template <size_t N> struct Step<N,N>
+		{
+			template <typename Tuple> static void setup(Tuple&,Environment*) {}
+			template <typename Tuple> static bool start(Tuple&) {return true;}
+			template <typename Tuple> static bool check(Tuple&,string&) {return true;}
+			template <typename Tuple> static bool stop(Tuple&) {return true;}
+			template <typename Tuple> static bool update(Tuple&,int,bool,map<string,Group3D*>&,map<string,Group2D*>&,map<string,Group1D*>&,map<string,GroupSwitch*>&) {return true;}
+		};
+	}
+
+	/*!
+	 * \class StaticPipeline
+	 * \brief Pipeline of Nodes whose types and order are fixed at compile time.
+	 * The Nodes are stored by value and updated in the order of the template parameters (Generators first, then Processors, then Observers),
+	 * with calls qualified by their exact class : the compiler resolves and can inline them instead of going through the virtual Node::update.
+	 * Generators are called through generate and Observers through observe (the maps of Groups are still copied, observe taking them by value),
+	 * except with the Data Copy option of the Environment, where they go through the update of the library (Generator::update, Observer::update).
+	 * The Environment is only used for its settings (historic length, data copy ...). Use an Environment (or a Scheduler) for prototyping,
+	 * and a StaticPipeline once the pipeline of a deployment is fixed (see the --static option of the template application).
+	 * The type identifiers only serve the checks : the Groups and the HistoricTemplate are still found by their type strings, as the
+	 * Nodes of the library look them up (getElementsByType ...).
+	 *
+	 * Example : StaticPipeline<MyGenerator,MyProcessor,MyObserver> pipeline(environment,MyGenerator("gen"),MyProcessor("proc"),MyObserver("obs"));
+	*/
+	template <typename... Nodes> class StaticPipeline
+	{
+		static_assert(pipeline::Satisfied<TypeIDs<>,Nodes...>::value,"libGina : a Node of the StaticPipeline needs a type which is not produced by a previous Node.");
+
+	private:
+		//! The Nodes, in their order of update
+		tuple<Nodes...> _nodes;
+
+		//! The Environment giving the settings to the Nodes
+		Environment* _environment;
+
+		//! Structure for storing Switch Data.
+		map<string, GroupSwitch*> _groupsSwitch;
+
+		//! Structure for storing 1D Data.
+		map<string, Group1D*> _groups1D;
+
+		//! Structure for storing 2D Data.
+		map<string, Group2D*> _groups2D;
+
+		//! Structure for storing 3D Data.
+		map<string, Group3D*> _groups3D;
+
+		//! Time informations : for getting current time.
+		Timer _timer;
+
+		//! Store the current time.
+		int _timestamp;
+
+		//! Last error.
+		string _error;
+
+		template <typename G> static void deleteGroups(map<string,G*>& groups)
+		{
+			for(typename map<string,G*>::iterator git = groups.begin();git != groups.end();git++) delete git->second;
+			groups.clear();
+		}
+
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param[in] environment : the Environment giving the settings to the Nodes
+		 * \param[in] nodes : the Nodes (copied), in their order of update
+		 */
+		StaticPipeline(Environment* environment,const Nodes&... nodes) : _nodes(nodes...),_environment(environment),_timer("ms"),_timestamp(0)
+		{
+			pipeline::Step<0,sizeof...(Nodes)>::setup(_nodes,_environment);
+		}
+
+		/*!
+		 * \brief Destructor
+		 */
+		~StaticPipeline(void)
+		{
+			deleteGroups(_groupsSwitch);
+			deleteGroups(_groups1D);
+			deleteGroups(_groups2D);
+			deleteGroups(_groups3D);
+		}
+
+		/*!
+		 * \brief Get a Node of the pipeline
+		 * \return The Node at the given position
+		 */
+		template <size_t I> typename tuple_element<I,tuple<Nodes...> >::type& getNode() {return get<I>(_nodes);}
+
+		/*!
+		 * \brief Check the declared types of the Nodes (StaticNeed, StaticProduce) against need, consume and produce, then start all the Nodes
+		 * and the time of the pipeline
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool start()
+		{
+			if(!pipeline::Step<0,sizeof...(Nodes)>::check(_nodes,_error)) return false;
+			_timer.start();
+			if(pipeline::Step<0,sizeof...(Nodes)>::start(_nodes)) return true;
+			_error = "libGina : Error : a Node of the StaticPipeline did not start.";
+			return false;
+		}
+
+		/*!
+		 * \brief Stop all the Nodes
+		 * \return true if success
+		 */
+		bool stop()
+		{
+			return pipeline::Step<0,sizeof...(Nodes)>::stop(_nodes);
+		}
+
+		/*!
+		 * \brief Update all the Nodes in their order
+		 * \return true if all the Nodes updated
+		 */
+		bool update()
+		{
+			_timestamp = _timer.getTimeFromStart();
+			return pipeline::Step<0,sizeof...(Nodes)>::update(_nodes,_timestamp,_environment->dataCopyEnabled(),_groups3D,_groups2D,_groups1D,_groupsSwitch);
+		}
+
+		/*!
+		 * \brief Get the current timestamp of the pipeline (given to the Nodes during update)
+		 * \return current timestamp
+		 */
+		inline int getTime() const {return _timestamp;}
+
+		/*!
+		 * \brief Get the last error of the pipeline
+		 * \return The last error
+		 */
+		inline string getLastError() const {return _error;}
+
+		/*!
+		 * \brief Get the Switch Groups at their current state
+		 * \return the map of the Switch groups
+		 */
+		inline const map<string, GroupSwitch*>& getGroupsSwitch() const {return _groupsSwitch;}
+
+		/*!
+		 * \brief Get the 1D Groups at their current state
+		 * \return the map of the 1D groups
+		 */
+		inline const map<string, Group1D*>& getGroups1D() const {return _groups1D;}
+
+		/*!
+		 * \brief Get the 2D Groups at their current state
+		 * \return the map of the 2D groups
+		 */
+		inline const map<string, Group2D*>& getGroups2D() const {return _groups2D;}
+
+		/*!
+		 * \brief Get the 3D Groups at their current state
+		 * \return the map of the 3D groups
+		 */
+		inline const map<string, Group3D*>& getGroups3D() const {return _groups3D;}
+	};
+}
+
+#endif /* LGSTATICPIPELINE_H_ */
@@ -0,0 +1,254 @@
+#pragma once
+
+/*!
+ * \file LgStatistics.h
+ * \brief File containing the classes for computing statistics on the successive values of an historic, updated at each new value.
+ * \version 0.2
+ * \date 19 october 2026
+ */
+
+#ifndef LGSTATISTICS_H_
+#define LGSTATISTICS_H_
+
+#include <deque>
+#include <map>
+
+#include "LgDataTemplate.h"
+#include "LgPoint2D.h"
+#include "LgPoint3D.h"
+#include "LgSwitch.h"
+
+using namespace std;
+
+/*!
+ * \namespace lg
+ * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
+*/
+namespace lg
+{
+	/*!
+	 * \class RunningStatistics
+	 * \brief Statistics of the last values of a scalar, updated in O(1) (amortized) at each new value.
+	 * Sum, mean and variance (Welford) are computed on a sliding window of values, the minimum and maximum with monotonic queues,
+	 * and an exponentially weighted average is kept on all the values.
+	*/
+	class RunningStatistics
+	{
+	private:
+		//! Maximum number of values in the window
+		int _window;
+
+		//! Weight of a new value in the exponentially weighted average (between 0.0 and 1.0)
+		float _smoothing;
+
+		//! Values of the window, the newest at the back
+		deque<float> _values;
+
+		//! Number of values added since the creation (or the last clear), used as index of the values
+		unsigned long _added;
+
+		//! Sum of the values of the window
+		double _sum;
+
+		//! Mean of the values of the window
+		double _mean;
+
+		//! Sum of the squared differences to the mean of the values of the window
+		double _m2;
+
+		//! Exponentially weighted average of all the values
+		double _average;
+
+		//! Exponentially weighted average before the last value (for replacing it)
+		double _previousAverage;
+
+		//! Candidates for the minimum (increasing values), with their indexes
+		deque<pair<unsigned long, float> > _minima;
+
+		//! Candidates for the maximum (decreasing values), with their indexes
+		deque<pair<unsigned long, float> > _maxima;
+
+		// Add or remove a value from the sum, the mean and the variance
+		void addMoments(float value);
+		void removeMoments(float value);
+
+		// Add the newest value in the monotonic queues, dropping the values which left the window
+		void pushExtrema(float value);
+
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param[in] window : the number of values on which sum, mean, variance, minimum and maximum are computed (at least 1)
+		 * \param[in] smoothing : the weight of a new value in the exponentially weighted average (between 0.0 and 1.0)
+		 */
+		RunningStatistics(int window = 32,float smoothing = 0.1f);
+
+		/*!
+		 * \brief Add a new value, the oldest one leaving the window if it is full
+		 * \param[in] value : the new value
+		 */
+		void add(float value);
+
+		/*!
+		 * \brief Replace the newest value (when a value has been rewritten at the same timestamp)
+		 * The minimum and maximum are rebuilt from the window (O(window)), the other statistics in O(1).
+		 * \param[in] value : the new value
+		 */
+		void replaceLast(float value);
+
+		/*!
+		 * \brief Remove all the values
+		 */
+		void clear();
+
+		/*!
+		 * \brief Get the number of values in the window
+		 * \return Number of values
+		 */
+		inline int getCount() const {return (int)_values.size();}
+
+		/*!
+		 * \brief Get the size of the window
+		 * \return Maximum number of values
+		 */
+		inline int getWindow() const {return _window;}
+
+		/*!
+		 * \brief Get the sum of the values of the window
+		 * \return The sum, 0 if there are no values
+		 */
+		inline float getSum() const {return (float)_sum;}
+
+		/*!
+		 * \brief Get the mean of the values of the window
+		 * \return The mean, 0 if there are no values
+		 */
+		inline float getMean() const {return (float)_mean;}
+
+		/*!
+		 * \brief Get the variance of the values of the window
+		 * \return The variance (population), 0 if there are less than two values
+		 */
+		float getVariance() const;
+
+		/*!
+		 * \brief Get the standard deviation of the values of the window
+		 * \return The standard deviation (population), 0 if there are less than two values
+		 */
+		float getStandardDeviation() const;
+
+		/*!
+		 * \brief Get the minimum of the values of the window
+		 * \return The minimum, 0 if there are no values
+		 */
+		inline float getMin() const {return _minima.empty() ? 0.0f : _minima.front().second;}
+
+		/*!
+		 * \brief Get the maximum of the values of the window
+		 * \return The maximum, 0 if there are no values
+		 */
+		inline float getMax() const {return _maxima.empty() ? 0.0f : _maxima.front().second;}
+
+		/*!
+		 * \brief Get the exponentially weighted average of all the values
+		 * \return The average, 0 if there are no values
+		 */
+		inline float getAverage() const {return (float)_average;}
+	};
+
+	// Components of the values on which statistics are computed (the position for Data)
+	inline int getStatisticsComponents(float value,float* components) {components[0] = value;return 1;}
+	inline int getStatisticsComponents(bool value,float* components) {components[0] = value ? 1.0f : 0.0f;return 1;}
+	inline int getStatisticsComponents(const Point2D& value,float* components) {components[0] = value.getX();components[1] = value.getY();return 2;}
+	inline int getStatisticsComponents(const Point3D& value,float* components) {components[0] = value.getX();components[1] = value.getY();components[2] = value.getZ();return 3;}
+	inline int getStatisticsComponents(const Switch& value,float* components) {return getStatisticsComponents(value.getState(),components);}
+	template <typename P,typename O> int getStatisticsComponents(const DataTemplate<P,O>& value,float* components) {return getStatisticsComponents(value.getPosition(),components);}
+
+	/*!
+	 * \class HistoricStatistics
+	 * \brief Statistics of each component (x, y, z) of the successive values of an HistoricTemplate.
+	 * Only the values added since the last update are read, so the cost of an update does not depend on the length of the historic.
+	*/
+	class HistoricStatistics
+	{
+	private:
+		//! Statistics of each component
+		RunningStatistics _components[3];
+
+		//! Number of components of the values (0 before the first value)
+		int _dimension;
+
+		//! Timestamp of the last value read
+		int _lastTimestamp;
+
+		//! Information whether a value has already been read
+		bool _started;
+
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param[in] window : the number of values on which sum, mean, variance, minimum and maximum are computed
+		 * \param[in] smoothing : the weight of a new value in the exponentially weighted average
+		 */
+		HistoricStatistics(int window = 32,float smoothing = 0.1f) : _dimension(0),_lastTimestamp(0),_started(false)
+		{
+			for(int i = 0;i < 3;i++) _components[i] = RunningStatistics(window,smoothing);
+		}
+
+		/*!
+		 * \brief Read the values added to an historic since the last update
+		 * A value rewritten at the last read timestamp replaces the previous one.
+		 * \param[in] historic : the values of the historic (see HistoricTemplate::getHistoric)
+		 */
+		template <typename T> void update(const map<int,T>& historic)
+		{
+			if(historic.empty()) return;
+
+			float components[3];
+			typename map<int,T>::const_iterator it = historic.begin();
+			if(_started)
+			{
+				it = historic.lower_bound(_lastTimestamp);
+				if((it != historic.end())&&(it->first == _lastTimestamp))
+				{
+					if(historic.rbegin()->first == _lastTimestamp)
+					{
+						int dimension = getStatisticsComponents(it->second,components);
+						for(int i = 0;i < dimension;i++) _components[i].replaceLast(components[i]);
+						return;
+					}
+					it++;
+				}
+			}
+
+			for(;it != historic.end();it++)
+			{
+				_dimension = getStatisticsComponents(it->second,components);
+				for(int i = 0;i < _dimension;i++) _components[i].add(components[i]);
+				_lastTimestamp = it->first;
+			}
+			_started = true;
+		}
+
+		/*!
+		 * \brief Get the number of components of the values
+		 * \return 1 for 1D Data and Switch, 2 for 2D Data, 3 for 3D Data (0 before the first value)
+		 */
+		inline int getDimension() const {return _dimension;}
+
+		/*!
+		 * \brief Get the timestamp of the last value read
+		 * \return The last timestamp, 0 before the first value
+		 */
+		inline int getLastTimestamp() const {return _lastTimestamp;}
+
+		/*!
+		 * \brief Get the statistics of a component
+		 * \param[in] component : 0 for x, 1 for y, 2 for z
+		 * \return The statistics of this component
+		 */
+		inline const RunningStatistics& get(int component) const {return _components[(component >= 0 && component < 3) ? component : 0];}
+	};
+}
+
+#endif /* LGSTATISTICS_H_ */
@@ -0,0 +1,125 @@
+#pragma once
+
+/*!
+ * \file LgThreadPool.h
+ * \brief File containing the ThreadPool class, a work-stealing pool of threads running batches of independent tasks.
+ * \version 0.2
+ * \date 19 october 2026
+ */
+
+#ifndef LGTHREADPOOL_H_
+#define LGTHREADPOOL_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/*!
+ * \namespace lg
+ * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
+*/
+namespace lg
+{
+	/*!
+	* \brief Type of the function running a task of a batch
+	* \param[in] index : the index of the task in the batch
+	* \param[in] context : the context given to ThreadPool::run
+	*/
+	typedef void TaskFunction(size_t index,void* context);
+
+	/*!
+	 * \class ThreadPool
+	 * \brief Pool of threads running batches of independent tasks (a task per Group ...), the thread calling run being one of them.
+	 * The tasks of a batch are dealt between the queues of the threads : each thread runs the tasks of its queue from the front,
+	 * then steals the tasks left at the back of the other queues, so a thread slowed by a long task does not delay the batch.
+	 * The threads wait on a condition variable between two batches.
+	*/
+	class ThreadPool
+	{
+	private:
+		/*!
+		 * \brief Tasks dealt to a thread
+		 */
+		struct TaskQueue
+		{
+			//! Mutex protecting the tasks
+			mutex lock;
+
+			//! Indexes of the tasks
+			deque<size_t> tasks;
+		};
+
+		//! Threads of the pool (the thread calling run is not one of them)
+		vector<thread> _threads;
+
+		//! Queues of the threads, the last one being the queue of the thread calling run
+		vector<TaskQueue*> _queues;
+
+		//! Mutex protecting the batch and the states of the pool
+		mutex _mutex;
+
+		//! Mutex allowing a single batch at a time
+		mutex _runMutex;
+
+		//! Signal for a new batch (or the destruction of the pool)
+		condition_variable _batchStarted;
+
+		//! Signal for the end of the last task of a batch
+		condition_variable _batchFinished;
+
+		//! Number of batches started, for waking up the threads once per batch
+		unsigned long _batch;
+
+		//! Information whether the pool is destroyed
+		bool _stopping;
+
+		//! Function and context of the current batch
+		TaskFunction* _function;
+		void* _context;
+
+		//! Number of tasks of the current batch not finished
+		atomic<size_t> _remaining;
+
+		// Main function of a thread of the pool
+		void work(size_t index);
+
+		// Run a task of the queue of a thread, or stolen from another queue, return false if all the queues are empty
+		bool runTask(size_t index);
+
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param[in] threadNumber : the number of threads running the tasks, including the thread calling run (1 runs them sequentially)
+		 */
+		ThreadPool(size_t threadNumber);
+
+		/*!
+		 * \brief Destructor (waits for the threads)
+		 */
+		~ThreadPool(void);
+
+		/*!
+		 * \brief Get the number of threads running the tasks
+		 * \return The number of threads, including the thread calling run
+		 */
+		inline size_t getThreadNumber() const {return _queues.size();}
+
+		/*!
+		 * \brief Run a batch of tasks and wait for all of them
+		 * The tasks must be independent : they can run concurrently and in any order.
+		 * \param[in] taskNumber : the number of tasks, the function is called once with each index from 0 to taskNumber - 1
+		 * \param[in] function : the function running a task
+		 * \param[in] context : a pointer given to the function
+		 */
+		void run(size_t taskNumber,TaskFunction* function,void* context);
+	};
+}
+
+#endif /* LGTHREADPOOL_H_ */
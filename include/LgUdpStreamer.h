@@ -0,0 +1,224 @@
+#pragma once
+
+/*!
+ * \file LgUdpStreamer.h
+ * \brief File containing the UdpStreamer class, an Observer streaming the observed Groups and probabilities in UDP datagrams (OSC or binary).
+ * \version 0.2
+ * \date 19 october 2026
+ */
+
+#ifndef LGUDPSTREAMER_H_
+#define LGUDPSTREAMER_H_
+
+/*!
+* \brief Format of the datagrams : OSC bundles (see UdpStreamer)
+*/
+#define LG_STREAM_OSC 0
+
+/*!
+* \brief Format of the datagrams : compact binary records (see UdpStreamer)
+*/
+#define LG_STREAM_BINARY 1
+
+/*!
+* \brief First bytes of a binary datagram ("LGST")
+*/
+#define LG_STREAM_MAGIC 0x4C475354u
+
+/*!
+* \brief Kind of a binary record holding a probability (the records of values hold the dimension of their Group : 3, 2, 1, or 0 for a Switch)
+*/
+#define LG_STREAM_PROBABILITY 255
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#if defined _WIN32  || defined _WIN64
+#else
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+#include "LgObserver.h"
+
+using namespace std;
+
+/*!
+ * \namespace lg
+ * \brief Namespace containing everything for managing libGina Environment, Node and Groups.
+*/
+namespace lg
+{
+	/*!
+	 * \class UdpStreamer
+	 * \brief Observer sending, at each update, the last value of each HistoricTemplate of the observed Groups and the probabilities
+	 * of some Observers to an UDP endpoint (POSIX systems only).
+	 * The values of an update are packed in as few datagrams as possible, built in buffers allocated once by start,
+	 * and sent with a single system call (sendmmsg on Linux). The socket never blocks : datagrams the system cannot take are dropped and counted.
+	 * The filters of the Observer (onlyObserveGroupIDs, ignorePointType ...) restrain the sent values.
+	 * For sending the probabilities computed in the same update, the Observers must be updated before the streamer (lower priority).
+	 *
+	 * The numbers are big-endian in both formats. The values are floats : position then orientation then confidence and intensity,
+	 * 8 for 3D (x, y, z, x, y, z ...), 5 for 2D (x, y, angle ...), 4 for 1D (x, 1 or 0 ...), 1 for a Switch (1 or 0).
+	 * - LG_STREAM_OSC : each datagram is an OSC bundle (time tag "immediately") of messages
+	 *   "prefix/groupID/type" with the timestamp (int32) then the floats, and "prefix/probability/observer/groupID" with the probability (float).
+	 * - LG_STREAM_BINARY : each datagram starts with LG_STREAM_MAGIC, the number of the update, the timestamp (int32),
+	 *   the index of the datagram in the update and the number of datagrams of the update (uint16 each), followed by records :
+	 *   kind (uint8, the dimension or LG_STREAM_PROBABILITY), two lengths (uint8), a zero byte, the two names (groupID and type,
+	 *   or observer and groupID) padded to 4 bytes, then the timestamp (int32) and the floats of a value, or the probability (float).
+	*/
+	class UdpStreamer : public Observer
+	{
+	private:
+		//! Address (IPv4) and port of the endpoint
+		string _host;
+		int _port;
+
+		//! Format of the datagrams (LG_STREAM_OSC or LG_STREAM_BINARY)
+		int _format;
+
+		//! Beginning of the OSC addresses
+		string _addressPrefix;
+
+		//! Maximum size of a datagram, and maximum number of datagrams by update
+		size_t _datagramSize;
+		size_t _datagramCapacity;
+
+		//! Observers whose probabilities are sent
+		vector<const Observer*> _probabilityNodes;
+
+		//! The socket, -1 if not started
+		int _socket;
+
+		//! Buffers of the datagrams (_datagramCapacity buffers of _datagramSize bytes), and the length of each of them
+		vector<char> _buffers;
+		vector<size_t> _lengths;
+
+		//! Number of datagrams of the current update
+		size_t _datagramCount;
+
+		//! Record being serialized
+		vector<char> _record;
+
+		//! Number of updates sent
+		uint32_t _frame;
+
+		//! Counters of the datagrams sent, of the datagrams dropped by the system, and of the values which did not fit in the datagrams
+		unsigned long _sentDatagrams;
+		unsigned long _droppedDatagrams;
+		unsigned long _droppedValues;
+
+		//! Description of the last error
+		string _error;
+
+#if defined _WIN32  || defined _WIN64
+#else
+		//! Address of the endpoint
+		struct sockaddr_in _address;
+
+#ifdef __linux__
+		//! Headers of the datagrams given to sendmmsg
+		vector<struct mmsghdr> _messages;
+		vector<struct iovec> _vectors;
+#endif
+#endif
+
+		// Add the record to the datagrams of the update, in a new datagram if it does not fit, return false if there is no datagram left
+		bool appendRecord();
+
+		// Serialize a value or a probability in the record
+		void serializeValue(const string& groupID,const string& type,int dimension,int timestamp,const float* values,int count);
+		void serializeProbability(const string& nodeName,const string& groupID,float probability);
+
+		// Serialize the last values of the observed Groups
+		template <typename H> void serializeGroups(const map<string,GroupTemplate<H>*>& groups);
+
+		// Send the datagrams of the update
+		void sendDatagrams();
+
+	public:
+		/*!
+		 * \brief Constructor
+		 * \param[in] name : a name for the instance of this Node
+		 * \param[in] host : the IPv4 address of the endpoint
+		 * \param[in] port : the UDP port of the endpoint
+		 * \param[in] format : LG_STREAM_OSC or LG_STREAM_BINARY
+		 * \param[in] datagramSize : the maximum size of a datagram (1472 fits in an Ethernet frame)
+		 * \param[in] datagramCapacity : the maximum number of datagrams by update
+		 */
+		UdpStreamer(string name,string host = "127.0.0.1",int port = 9000,int format = LG_STREAM_OSC,size_t datagramSize = 1472,size_t datagramCapacity = 16);
+
+		/*!
+		 * \brief Destructor (closes the socket if still started)
+		 */
+		~UdpStreamer(void);
+
+		/*!
+		 * \brief Send the probabilities of an Observer (under the name of the Observer)
+		 * \param[in] observer : the Observer, which must stay alive while the streamer is updated
+		 */
+		void publishProbabilities(const Observer* observer);
+
+		/*!
+		 * \brief Set the beginning of the OSC addresses ("/lg" by default)
+		 * \param[in] prefix : the prefix, starting with '/'
+		 */
+		inline void setAddressPrefix(string prefix) {_addressPrefix = prefix;}
+
+		/*!
+		 * \brief Get the number of datagrams sent since the creation of the streamer
+		 * \return The number of datagrams
+		 */
+		inline unsigned long getSentDatagrams() const {return _sentDatagrams;}
+
+		/*!
+		 * \brief Get the number of datagrams not taken by the system (full buffer of the socket ...)
+		 * \return The number of datagrams
+		 */
+		inline unsigned long getDroppedDatagrams() const {return _droppedDatagrams;}
+
+		/*!
+		 * \brief Get the number of values and probabilities which did not fit in the datagrams of their update
+		 * \return The number of values
+		 */
+		inline unsigned long getDroppedValues() const {return _droppedValues;}
+
+		Node* clone(string cloneName) const;
+
+		/*!
+		 * \brief Open the socket and allocate the datagrams
+		 * \return true if success, false in other cases (use getLastError() for getting the problem)
+		 */
+		bool start();
+
+		/*!
+		 * \brief Close the socket
+		 * \return true
+		 */
+		bool stop();
+
+		/*!
+		 * \brief Send the last values of the Groups and the probabilities of the published Observers
+		 * \return true if success, false if not started
+		 */
+		bool observe(map<string,Group3D*> groups3D,map<string,Group2D*> groups2D,map<string,Group1D*> groups1D,map<string,GroupSwitch*> groupsSwitch);
+
+		/*!
+		 * \brief Return the types needed by the streamer : none, it sends all the Groups it receives
+		 * \return An empty set
+		 */
+		set<string> need() const {return set<string>();}
+
+		/*!
+		 * \brief Get the last error
+		 * \return A description of the last error
+		 */
+		inline string getLastError() const {return _error;}
+	};
+}
+
+#endif /* LGUDPSTREAMER_H_ */
@@ -2,6 +2,10 @@
 #include <signal.h>
 
 #include "LgEnvironment.h"
+#include "LgNodeFactory.h"
+#include "LgPipelineConfig.h"
+#include "LgScheduler.h"
+#include "LgStaticPipeline.h"
 #include "mygenerator.h"
 #include "myprocessor.h"
 #include "myobserver.h"
@@ -30,41 +34,80 @@ int main(int argc, char *argv[])
     environment->enableDataCopy(false);
     environment->setHistoricLength(3);
 
-    // HERE, declare your generators/processors/observers and add it to the environment
-    /******************************************************************* GENERATOR
-    ******************************************************************************/
-    MyGenerator* myGen = new MyGenerator("myGenerator");
-    if(environment->registerNode(myGen))
-        printf("Register MyGenerator OK.\n");
-    else
-        printf("%s.\n",environment->getLastError().c_str());
+    // Same nodes in a pipeline fixed at compile time : no registration, no virtual calls (see LgStaticPipeline.h)
+    if((argc > 1)&&(string(argv[1]) == "--static"))
+    {
+        StaticPipeline<MyGenerator,MyProcessor,MyObserver> pipeline(environment,MyGenerator("myGenerator"),MyProcessor("myProcessor"),MyObserver("myObserver"));
+        if(!pipeline.start())
+        {
+            cerr << "Pipeline not started : " << pipeline.getLastError() << endl;
+            return 2;
+        }
+
+        while(!finish)
+        {
+            pipeline.update();
+        }
+
+        pipeline.stop();
+        delete environment;
+        return 0;
+    }
 
-    /******************************************************************* PROCESSOR
-    ******************************************************************************/
-    MyProcessor* myProc = new MyProcessor("myProcessor");
-    if(environment->registerNode(myProc))
-        printf("Register MyProcessor OK.\n");
-    else
-        printf("%s.\n",environment->getLastError().c_str());
+    // Scheduler registering the nodes in the environment, keeping their compatibility up to date and updating them
+    Scheduler* scheduler = new Scheduler(environment);
 
-    /******************************************************************** OBSERVER
-    ******************************************************************************/
-    MyObserver* myObs = new MyObserver("myObserver");
-    if(environment->registerNode(myObs))
-        printf("Register MyObserver OK.\n");
+    // Pipeline described in a file (see LgPipelineConfig.h) : the nodes are created from the NodeFactory by their class names
+    if(argc > 1)
+    {
+        NodeFactory::registerNode("MyGenerator",new MyGenerator("myGenerator"));
+        NodeFactory::registerNode("MyProcessor",new MyProcessor("myProcessor"));
+        NodeFactory::registerNode("MyObserver",new MyObserver("myObserver"));
+
+        PipelineConfig pipeline;
+        if((!pipeline.load(argv[1]))||(!pipeline.apply(scheduler)))
+        {
+            cerr << pipeline.getLastError() << endl;
+            return 2;
+        }
+    }
     else
-        printf("%s.\n",environment->getLastError().c_str());
-
+    {
+        // HERE, declare your generators/processors/observers and add it to the environment
+        /******************************************************************* GENERATOR
+        ******************************************************************************/
+        MyGenerator* myGen = new MyGenerator("myGenerator");
+        if(scheduler->registerNode(myGen))
+            printf("Register MyGenerator OK.\n");
+        else
+            printf("%s.\n",scheduler->getLastError().c_str());
+
+        /******************************************************************* PROCESSOR
+        ******************************************************************************/
+        MyProcessor* myProc = new MyProcessor("myProcessor");
+        if(scheduler->registerNode(myProc))
+            printf("Register MyProcessor OK.\n");
+        else
+            printf("%s.\n",scheduler->getLastError().c_str());
+
+        /******************************************************************** OBSERVER
+        ******************************************************************************/
+        MyObserver* myObs = new MyObserver("myObserver");
+        if(scheduler->registerNode(myObs))
+            printf("Register MyObserver OK.\n");
+        else
+            printf("%s.\n",scheduler->getLastError().c_str());
+    }
 
     // Check if your generators/processors/observers are commpatible
-    if(!environment->checkCompatibility())
+    if(!scheduler->checkCompatibility())
     {
-        cerr << "Nodes are not compatible." << endl;
+        cerr << "Nodes are not compatible : " << scheduler->getLastError() << endl;
         return 2;
     }
 
     // Check if you started the environment
-    if(!environment->start())
+    if(!scheduler->start())
     {
         cerr << "Environnement not started." << endl;
         return 2;
@@ -72,11 +115,12 @@ int main(int argc, char *argv[])
 
     while(!finish)
     {
-        environment->update();
+        scheduler->update();
     }
 
-    environment->stop();
+    scheduler->stop();
 
+    delete scheduler;
     delete environment;
 
     return 0;
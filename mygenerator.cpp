@@ -10,7 +10,7 @@ MyGenerator::~MyGenerator()
 
 Node* MyGenerator::clone(string cloneName) const
 {
-    return (Node*)this;
+    return new MyGenerator(cloneName);
 }
 
 bool MyGenerator::start()
@@ -2,12 +2,16 @@
 #define MYGENERATOR_H
 
 #include "LgGenerator.h"
+#include "LgStaticPipeline.h"
 
 using namespace lg;
 
 class MyGenerator: public Generator
 {
 public:
+    //! Types produced, checked at compile time in a StaticPipeline
+    typedef TypeIDs<LG_TYPE_ID(LG_ORIENTEDPOINT3D_RIGHT_HAND)> StaticProduce;
+
     MyGenerator(string name);
     ~MyGenerator();
 
@@ -10,7 +10,9 @@ MyObserver::~MyObserver()
 
 Node* MyObserver::clone(string cloneName) const
 {
-    return new MyObserver("CloneMyObserver");
+    MyObserver* clone = new MyObserver(cloneName);
+    clone->copyFilters(*this);
+    return clone;
 }
 
 bool MyObserver::start()
@@ -2,12 +2,16 @@
 #define MYOBSERVER_H
 
 #include "LgObserver.h"
+#include "LgStaticPipeline.h"
 
 using namespace lg;
 
 class MyObserver: public Observer
 {
 public:
+    //! Types needed, checked at compile time in a StaticPipeline
+    typedef TypeIDs<LG_TYPE_ID(LG_ORIENTEDPOINT3D_RIGHT_HAND),LG_TYPE_ID("LG_ORIENTEDPOINT3D_RIGHT_HAND_PROCESSED")> StaticNeed;
+
     MyObserver(string);
     ~MyObserver();
 
@@ -12,7 +12,9 @@ MyProcessor::~MyProcessor()
 
 Node* MyProcessor::clone(string cloneName) const
 {
-    return (Node*)this;
+    MyProcessor* clone = new MyProcessor(cloneName);
+    clone->copyFilters(*this);
+    return clone;
 }
 
 bool MyProcessor::start()
@@ -43,7 +45,8 @@ bool MyProcessor::update(map<string,Group3D*>& g3D,map<string,Group2D*>& g2D,map
                 newPos.setY(newPos.getY()/10);
                 newPos.setZ(newPos.getZ()/10);
 
-                updateData(_environment, g3D, "ID1", "aName", "LG_ORIENTEDPOINT3D_RIGHT_HAND_PROCESSED", "LG_ORIENTEDPOINT3D_RIGHT_HAND_PROCESSED", _timestamp, OrientedPoint3D(newPos, hp->getOrientation(), 1.0, 1.0));
+                // the processed hand goes into the Group of the hand (it used to go into a fixed Group "ID1" of type "aName")
+                updateData(_environment, g3D, mit->first, mit->second->getType(), "LG_ORIENTEDPOINT3D_RIGHT_HAND_PROCESSED", "LG_ORIENTEDPOINT3D_RIGHT_HAND_PROCESSED", _timestamp, OrientedPoint3D(newPos, hp->getOrientation(), 1.0, 1.0));
             }
         }
     }
@@ -2,12 +2,17 @@
 #define MYPROCESSOR_H
 
 #include "LgProcessor.h"
+#include "LgStaticPipeline.h"
 
 using namespace lg;
 
 class MyProcessor: public Processor
 {
 public:
+    //! Types needed and produced, checked at compile time in a StaticPipeline
+    typedef TypeIDs<LG_TYPE_ID(LG_ORIENTEDPOINT3D_RIGHT_HAND)> StaticNeed;
+    typedef TypeIDs<LG_TYPE_ID("LG_ORIENTEDPOINT3D_RIGHT_HAND_PROCESSED")> StaticProduce;
+
     MyProcessor(string);
     ~MyProcessor();
 
@@ -0,0 +1,267 @@
+#include "LgCompatibilityGraph.h"
+
+#include <vector>
+
+namespace lg
+{
+	void CompatibilityGraph::setMissing(const string& nodeName,const string& type,bool missing)
+	{
+		if(missing)
+		{
+			_missing[nodeName].insert(type);
+			return;
+		}
+
+		map<string, set<string> >::iterator mit = _missing.find(nodeName);
+		if(mit == _missing.end()) return;
+		mit->second.erase(type);
+		if(mit->second.empty()) _missing.erase(mit);
+	}
+
+	string CompatibilityGraph::getFeeder(const string& type,int priority) const
+	{
+		map<string, map<int, string> >::const_iterator wit = _writers.find(type);
+		if(wit == _writers.end()) return string();
+
+		// The last Node producing or consuming the type before the priority decides whether it is available
+		map<int, string>::const_iterator nit = wit->second.lower_bound(priority);
+		if(nit == wit->second.begin()) return string();
+		nit--;
+		map<string, Vertex>::const_iterator vit = _vertices.find(nit->second);
+		if((vit == _vertices.end())||(vit->second.produce.count(type) == 0)) return string();
+		return nit->second;
+	}
+
+	void CompatibilityGraph::refreshReaders(const string& type,int priority)
+	{
+		map<string, map<int, string> >::iterator rit = _readers.find(type);
+		if(rit == _readers.end()) return;
+
+		// The Nodes after the next writer only depend on this writer
+		bool bounded = false;
+		int last = priority;
+		map<string, map<int, string> >::iterator wit = _writers.find(type);
+		if(wit != _writers.end())
+		{
+			map<int, string>::iterator next = wit->second.upper_bound(priority);
+			if(next != wit->second.end())
+			{
+				bounded = true;
+				last = next->first;
+			}
+		}
+
+		for(map<int, string>::iterator nit = rit->second.lower_bound(priority);(nit != rit->second.end())&&((!bounded)||(nit->first <= last));nit++)
+			setMissing(nit->second,type,getFeeder(type,nit->first).empty());
+	}
+
+	set<string> CompatibilityGraph::getTypeSuccessors(const string& uniqueName) const
+	{
+		set<string> successors;
+		map<string, Vertex>::const_iterator vit = _vertices.find(uniqueName);
+		if(vit == _vertices.end()) return successors;
+
+		for(set<string>::const_iterator it = vit->second.produce.begin();it != vit->second.produce.end();it++)
+		{
+			map<string, map<int, string> >::const_iterator rit = _readers.find(*it);
+			if(rit == _readers.end()) continue;
+
+			// In place transforms of the same type do not depend on each other
+			for(map<int, string>::const_iterator nit = rit->second.begin();nit != rit->second.end();nit++)
+			{
+				if(!vit->second.isInPlace(*it))
+				{
+					successors.insert(nit->second);
+					continue;
+				}
+				map<string, Vertex>::const_iterator sit = _vertices.find(nit->second);
+				if((sit == _vertices.end())||(!sit->second.isInPlace(*it))) successors.insert(nit->second);
+			}
+		}
+		successors.erase(uniqueName);
+		return successors;
+	}
+
+	bool CompatibilityGraph::findCycle(const string& nodeName)
+	{
+		// Iterative depth-first search from the successors of the Node, keeping the path for marking it
+		map<string,string> parents;
+		vector<string> stack;
+
+		set<string> successors = getTypeSuccessors(nodeName);
+		for(set<string>::iterator sit = successors.begin();sit != successors.end();sit++)
+		{
+			parents[*sit] = nodeName;
+			stack.push_back(*sit);
+		}
+
+		while(!stack.empty())
+		{
+			string current = stack.back();
+			stack.pop_back();
+
+			if(current == nodeName)
+			{
+				// Walk back the path up to the Node
+				string step = parents[nodeName];
+				_cyclic.insert(nodeName);
+				while(step != nodeName)
+				{
+					_cyclic.insert(step);
+					step = parents[step];
+				}
+				return true;
+			}
+
+			successors = getTypeSuccessors(current);
+			for(set<string>::iterator sit = successors.begin();sit != successors.end();sit++)
+			{
+				if((*sit != nodeName)&&(parents.count(*sit))) continue;
+				if(*sit == nodeName) parents[nodeName] = current;
+				else parents[*sit] = current;
+				stack.push_back(*sit);
+			}
+		}
+		return false;
+	}
+
+	bool CompatibilityGraph::addNode(const string& uniqueName,const Node* node,int priority)
+	{
+		if((node == 0)||(_vertices.count(uniqueName))||(_priorities.count(priority))) return false;
+
+		Vertex& vertex = _vertices[uniqueName];
+		vertex.priority = priority;
+		vertex.need = node->need();
+		vertex.consume = node->consume();
+		vertex.produce = node->produce();
+		_priorities[priority] = uniqueName;
+
+		set<string> types = vertex.need;
+		types.insert(vertex.consume.begin(),vertex.consume.end());
+		for(set<string>::iterator it = types.begin();it != types.end();it++) _readers[*it][priority] = uniqueName;
+		for(set<string>::iterator it = vertex.consume.begin();it != vertex.consume.end();it++) _writers[*it][priority] = uniqueName;
+		for(set<string>::iterator it = vertex.produce.begin();it != vertex.produce.end();it++)
+		{
+			_producers[*it].insert(uniqueName);
+			_writers[*it][priority] = uniqueName;
+		}
+
+		// The new Node and the Nodes reading its types after it, up to the next writer of each type
+		types.insert(vertex.produce.begin(),vertex.produce.end());
+		for(set<string>::iterator it = types.begin();it != types.end();it++) refreshReaders(*it,priority);
+
+		if(_cycleRejection) findCycle(uniqueName);
+		return true;
+	}
+
+	bool CompatibilityGraph::removeNode(const string& uniqueName)
+	{
+		map<string, Vertex>::iterator vit = _vertices.find(uniqueName);
+		if(vit == _vertices.end()) return false;
+
+		Vertex vertex = vit->second;
+		_vertices.erase(vit);
+		_priorities.erase(vertex.priority);
+		_missing.erase(uniqueName);
+
+		set<string> types = vertex.need;
+		types.insert(vertex.consume.begin(),vertex.consume.end());
+		types.insert(vertex.produce.begin(),vertex.produce.end());
+		map<string, map<int, string> >* indices[2] = {&_readers,&_writers};
+		for(set<string>::iterator it = types.begin();it != types.end();it++)
+		{
+			for(int i = 0;i < 2;i++)
+			{
+				map<string, map<int, string> >::iterator iit = indices[i]->find(*it);
+				if(iit == indices[i]->end()) continue;
+				iit->second.erase(vertex.priority);
+				if(iit->second.empty()) indices[i]->erase(iit);
+			}
+
+			map<string, set<string> >::iterator pit = _producers.find(*it);
+			if(pit == _producers.end()) continue;
+			pit->second.erase(uniqueName);
+			if(pit->second.empty()) _producers.erase(pit);
+		}
+
+		// The Nodes reading its types after it may have lost their producer, or found one again (the Node consumed a type)
+		for(set<string>::iterator it = types.begin();it != types.end();it++) refreshReaders(*it,vertex.priority);
+
+		// Removing a Node cannot create a cycle, only break the known ones
+		if(!_cyclic.empty())
+		{
+			set<string> previous = _cyclic;
+			previous.erase(uniqueName);
+			_cyclic.clear();
+			for(set<string>::iterator it = previous.begin();it != previous.end();it++)
+				if(_cyclic.count(*it) == 0) findCycle(*it);
+		}
+
+		return true;
+	}
+
+	bool CompatibilityGraph::isConsumed(const string& uniqueName,const string& type) const
+	{
+		map<string, Vertex>::const_iterator vit = _vertices.find(uniqueName);
+		return ((vit != _vertices.end())&&(vit->second.consume.count(type) > 0));
+	}
+
+	void CompatibilityGraph::enableCycleRejection(bool enabled)
+	{
+		_cycleRejection = enabled;
+		_cyclic.clear();
+		if(!enabled) return;
+
+		for(map<string, Vertex>::iterator vit = _vertices.begin();vit != _vertices.end();vit++)
+			if(_cyclic.count(vit->first) == 0) findCycle(vit->first);
+	}
+
+	set<string> CompatibilityGraph::getProducers(const string& type) const
+	{
+		map<string, set<string> >::const_iterator pit = _producers.find(type);
+		if(pit == _producers.end()) return set<string>();
+		return pit->second;
+	}
+
+	set<string> CompatibilityGraph::getConsumers(const string& type) const
+	{
+		set<string> consumers;
+		map<string, map<int, string> >::const_iterator rit = _readers.find(type);
+		if(rit == _readers.end()) return consumers;
+		for(map<int, string>::const_iterator nit = rit->second.begin();nit != rit->second.end();nit++) consumers.insert(nit->second);
+		return consumers;
+	}
+
+	set<string> CompatibilityGraph::getSuccessors(const string& uniqueName) const
+	{
+		set<string> successors;
+		map<string, Vertex>::const_iterator vit = _vertices.find(uniqueName);
+		if(vit == _vertices.end()) return successors;
+
+		for(set<string>::const_iterator it = vit->second.produce.begin();it != vit->second.produce.end();it++)
+		{
+			map<string, map<int, string> >::const_iterator rit = _readers.find(*it);
+			if(rit == _readers.end()) continue;
+
+			// The output stays available up to the first Node consuming it without producing it again
+			for(map<int, string>::const_iterator nit = rit->second.upper_bound(vit->second.priority);nit != rit->second.end();nit++)
+			{
+				successors.insert(nit->second);
+				map<string, Vertex>::const_iterator sit = _vertices.find(nit->second);
+				if((sit != _vertices.end())&&(sit->second.consume.count(*it))&&(sit->second.produce.count(*it) == 0)) break;
+			}
+		}
+		return successors;
+	}
+
+	void CompatibilityGraph::clear()
+	{
+		_vertices.clear();
+		_priorities.clear();
+		_producers.clear();
+		_readers.clear();
+		_writers.clear();
+		_missing.clear();
+		_cyclic.clear();
+	}
+}
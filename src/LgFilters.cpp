@@ -0,0 +1,485 @@
+#include "LgFilters.h"
+
+#include <math.h>
+
+#include "LgScheduler.h"
+
+namespace lg
+{
+	// Smoothing factor of an exponential low-pass filter of the given cutoff frequency
+	static inline float lowPassAlpha(float cutoff,float dt)
+	{
+		float tau = 1.0f/(2.0f*(float)M_PI*cutoff);
+		return 1.0f/(1.0f + tau/dt);
+	}
+
+	void PointBatch3D::clear()
+	{
+		ids.clear();
+		types.clear();
+		historics.clear();
+		x.clear();
+		y.clear();
+		z.clear();
+		orientations.clear();
+		confidences.clear();
+		intensities.clear();
+		timestamps.clear();
+		filtered.clear();
+	}
+
+	void PointBatch3D::add(HOrientedPoint3D* historic)
+	{
+		OrientedPoint3D* last = historic->getLast();
+		ids.push_back(historic->getID());
+		types.push_back(historic->getType());
+		historics.push_back(historic);
+		x.push_back(last->getPosition().getX());
+		y.push_back(last->getPosition().getY());
+		z.push_back(last->getPosition().getZ());
+		orientations.push_back(last->getOrientation());
+		confidences.push_back(last->getConfidence());
+		intensities.push_back(last->getIntensity());
+		timestamps.push_back(historic->getLastTimestamp());
+		filtered.push_back(0);
+	}
+
+	void FilterState::setPoints(const vector<string>& pointIDs,int size)
+	{
+		size_t previousCount = ids.size();
+		size_t pointCount = pointIDs.size();
+		vector<float> pointValues(size*3*pointCount,0.0f);
+		vector<int> pointTimestamps(pointCount,0);
+		vector<int> pointCounts(pointCount,0);
+
+		// The points are usually in the same order : the search starts after the previous point found
+		size_t j = 0;
+		for(size_t i = 0;i < pointCount;i++)
+		{
+			size_t k = 0;
+			while((k < previousCount)&&(ids[(j + k) % previousCount] != pointIDs[i])) k++;
+			if(k == previousCount) continue;
+
+			j = (j + k) % previousCount;
+			for(int row = 0;row < size*3;row++) pointValues[row*pointCount + i] = values[row*previousCount + j];
+			pointTimestamps[i] = timestamps[j];
+			pointCounts[i] = counts[j];
+			j = (j + 1) % previousCount;
+		}
+
+		ids = pointIDs;
+		values.swap(pointValues);
+		timestamps.swap(pointTimestamps);
+		counts.swap(pointCounts);
+	}
+
+	Node* FilterProcessor::copyRestrictions(FilterProcessor* clone) const
+	{
+		clone->copyFilters(*this);
+		clone->_inPlace = _inPlace;
+		return clone;
+	}
+
+	bool FilterProcessor::start()
+	{
+		_states.clear();
+		return true;
+	}
+
+	bool FilterProcessor::stop()
+	{
+		return true;
+	}
+
+	bool FilterProcessor::update(map<string,Group3D*>& groups3D,map<string,Group2D*>&,map<string,Group1D*>&,map<string,GroupSwitch*>&)
+	{
+		return updateChain(vector<FilterProcessor*>(1,this),groups3D);
+	}
+
+	bool FilterProcessor::canFuseWith(const FilterProcessor* next) const
+	{
+		return ((_inPlace)&&(next->_inPlace)&&(_types == next->_types)
+			&&(_observedGroups == next->_observedGroups)&&(_observedGroupType == next->_observedGroupType)&&(_observedPointType == next->_observedPointType)
+			&&(_ignoredGroups == next->_ignoredGroups)&&(_ignoredGroupType == next->_ignoredGroupType)&&(_ignoredPointType == next->_ignoredPointType));
+	}
+
+	// Time since the last filtered value of a point, in seconds (0 at its first value)
+	static inline float getDelta(const FilterState& state,size_t point,int timestamp)
+	{
+		return (state.counts[point] > 0) ? (float)(timestamp - state.timestamps[point])*0.001f : 0.0f;
+	}
+
+	// Check if the last value of a point has not been filtered yet
+	static inline bool isNewValue(const PointBatch3D& batch,const FilterState& state,size_t point)
+	{
+		return (state.counts[point] == 0)||(batch.timestamps[point] != state.timestamps[point]);
+	}
+
+	bool FilterProcessor::processBatch(PointBatch3D& batch,const string& groupID)
+	{
+		FilterState& state = _states[groupID];
+		int size = getStateSize();
+		size_t pointCount = batch.size();
+		if(pointCount == 0) return false;
+		if(state.ids != batch.ids) state.setPoints(batch.ids,size);
+
+		// Usual case : all the points have a new value at the same time and are at the same step, they are filtered together in the state
+		bool together = true;
+		for(size_t i = 0;(i < pointCount)&&(together);i++)
+		{
+			together = (isNewValue(batch,state,i))&&(state.counts[i] == state.counts[0])&&(state.timestamps[i] == state.timestamps[0])
+				&&(batch.timestamps[i] == batch.timestamps[0]);
+		}
+		if(together)
+		{
+			state.count = state.counts[0];
+			filterBatch(batch,state,getDelta(state,0,batch.timestamps[0]));
+			for(size_t i = 0;i < pointCount;i++)
+			{
+				state.timestamps[i] = batch.timestamps[i];
+				state.counts[i]++;
+				batch.filtered[i] = 1;
+			}
+			return true;
+		}
+
+		// Otherwise, the points with a new value are filtered by sets of points at the same step (a filtered point has no new value anymore)
+		bool filtered = false;
+		for(size_t i = 0;i < pointCount;i++)
+		{
+			if(!isNewValue(batch,state,i)) continue;
+
+			_subPoints.clear();
+			for(size_t j = i;j < pointCount;j++)
+			{
+				if((isNewValue(batch,state,j))&&(state.counts[j] == state.counts[i])&&(state.timestamps[j] == state.timestamps[i])
+					&&(batch.timestamps[j] == batch.timestamps[i])) _subPoints.push_back(j);
+			}
+			filterPoints(batch,state,_subPoints);
+			filtered = true;
+		}
+		return filtered;
+	}
+
+	void FilterProcessor::filterPoints(PointBatch3D& batch,FilterState& state,const vector<size_t>& points)
+	{
+		// Gather the coordinates and the values of the points (the filters only read the coordinates of the batch)
+		int size = getStateSize();
+		size_t pointCount = batch.size();
+		size_t subCount = points.size();
+		_subBatch.ids.resize(subCount);
+		_subBatch.x.resize(subCount);
+		_subBatch.y.resize(subCount);
+		_subBatch.z.resize(subCount);
+		_subState.ids.resize(subCount);
+		_subState.values.resize(size*3*subCount);
+		_subState.count = state.counts[points[0]];
+		for(size_t k = 0;k < subCount;k++)
+		{
+			size_t i = points[k];
+			_subBatch.ids[k] = batch.ids[i];
+			_subBatch.x[k] = batch.x[i];
+			_subBatch.y[k] = batch.y[i];
+			_subBatch.z[k] = batch.z[i];
+			for(int row = 0;row < size*3;row++) _subState.values[row*subCount + k] = state.values[row*pointCount + i];
+		}
+
+		filterBatch(_subBatch,_subState,getDelta(state,points[0],batch.timestamps[points[0]]));
+
+		// Scatter
+		for(size_t k = 0;k < subCount;k++)
+		{
+			size_t i = points[k];
+			batch.x[i] = _subBatch.x[k];
+			batch.y[i] = _subBatch.y[k];
+			batch.z[i] = _subBatch.z[k];
+			for(int row = 0;row < size*3;row++) state.values[row*pointCount + i] = _subState.values[row*subCount + k];
+			state.timestamps[i] = batch.timestamps[i];
+			state.counts[i]++;
+			batch.filtered[i] = 1;
+		}
+	}
+
+	bool FilterProcessor::updateChain(const vector<FilterProcessor*>& chain,map<string,Group3D*>& groups3D)
+	{
+		if(chain.empty()) return true;
+		FilterProcessor* head = chain.front();
+
+		// States of the Groups which disappeared, when all the Groups are given (without a Scheduler)
+		if(getSchedulerOfEnvironment(head->_environment) == 0)
+		{
+			for(vector<FilterProcessor*>::const_iterator it = chain.begin();it != chain.end();it++)
+			{
+				map<string, FilterState>::iterator sit = (*it)->_states.begin();
+				while(sit != (*it)->_states.end())
+				{
+					if(groups3D.count(sit->first)) sit++;
+					else (*it)->_states.erase(sit++);
+				}
+			}
+		}
+
+		PointBatch3D& batch = head->_batch;
+		for(map<string,Group3D*>::iterator git = groups3D.begin();git != groups3D.end();git++)
+		{
+			if(!head->isProcessedGroup(git->first,git->second->getType())) continue;
+
+			// Gather
+			batch.clear();
+			const map<string,HOrientedPoint3D*>& elements = git->second->getAll();
+			for(map<string,HOrientedPoint3D*>::const_iterator eit = elements.begin();eit != elements.end();eit++)
+			{
+				string type = eit->second->getType();
+				if((head->_types.count(type) == 0)||(!head->isProcessedType(type))||(eit->second->isEmpty())) continue;
+				batch.add(eit->second);
+			}
+			if(batch.size() == 0) continue;
+
+			// Filter, each stage reading the values filtered by the previous one
+			bool filtered = false;
+			for(vector<FilterProcessor*>::const_iterator it = chain.begin();it != chain.end();it++)
+				if((*it)->processBatch(batch,git->first)) filtered = true;
+			if(!filtered) continue;
+
+			// Scatter
+			for(size_t i = 0;i < batch.size();i++)
+			{
+				if(!batch.filtered[i]) continue;
+				if(head->_inPlace)
+				{
+					rewriteLast(batch.historics[i],OrientedPoint3D(Point3D(batch.x[i],batch.y[i],batch.z[i]),batch.orientations[i],batch.confidences[i],batch.intensities[i]));
+					continue;
+				}
+				updateData(head->_environment,groups3D,git->first,git->second->getType(),batch.ids[i] + LG_FILTER_OUTPUT_SUFFIX,batch.types[i] + LG_FILTER_OUTPUT_SUFFIX,
+					head->_timestamp,OrientedPoint3D(Point3D(batch.x[i],batch.y[i],batch.z[i]),batch.orientations[i],batch.confidences[i],batch.intensities[i]));
+			}
+		}
+		return true;
+	}
+
+	set<string> FilterProcessor::need() const
+	{
+		set<string> need;
+		if(_inPlace) return need;
+		for(set<string>::const_iterator it = _types.begin();it != _types.end();it++)
+			if(isProcessedType(*it)) need.insert(*it);
+		return need;
+	}
+
+	set<string> FilterProcessor::consume() const
+	{
+		set<string> consume;
+		if(!_inPlace) return consume;
+		for(set<string>::const_iterator it = _types.begin();it != _types.end();it++)
+			if(isProcessedType(*it)) consume.insert(*it);
+		return consume;
+	}
+
+	set<string> FilterProcessor::produce() const
+	{
+		set<string> produce;
+		for(set<string>::const_iterator it = _types.begin();it != _types.end();it++)
+			if(isProcessedType(*it)) produce.insert(_inPlace ? *it : *it + LG_FILTER_OUTPUT_SUFFIX);
+		return produce;
+	}
+
+	OneEuroFilterProcessor::OneEuroFilterProcessor(string name,const set<string>& types,float minCutoff,float beta,float derivativeCutoff) : FilterProcessor(name,types),_minCutoff(minCutoff),_beta(beta),_derivativeCutoff(derivativeCutoff)
+	{
+	}
+
+	Node* OneEuroFilterProcessor::clone(string cloneName) const
+	{
+		return copyRestrictions(new OneEuroFilterProcessor(cloneName,_types,_minCutoff,_beta,_derivativeCutoff));
+	}
+
+	void OneEuroFilterProcessor::filterBatch(PointBatch3D& batch,FilterState& state,float dt)
+	{
+		size_t size = batch.size();
+		for(int c = 0;c < 3;c++)
+		{
+			float* values = batch.coordinate(c);
+			float* previous = state.get(0,c);
+			float* derivative = state.get(1,c);
+
+			if((state.count == 0)||(dt <= 0.0f))
+			{
+				for(size_t i = 0;i < size;i++) previous[i] = values[i];
+				continue;
+			}
+
+			float derivativeAlpha = lowPassAlpha(_derivativeCutoff,dt);
+			for(size_t i = 0;i < size;i++)
+			{
+				float speed = derivative[i] + derivativeAlpha*((values[i] - previous[i])/dt - derivative[i]);
+				float alpha = lowPassAlpha(_minCutoff + _beta*fabsf(speed),dt);
+				float filtered = previous[i] + alpha*(values[i] - previous[i]);
+				derivative[i] = speed;
+				previous[i] = filtered;
+				values[i] = filtered;
+			}
+		}
+	}
+
+	KalmanFilterProcessor::KalmanFilterProcessor(string name,const set<string>& types,float processNoise,float measurementNoise) : FilterProcessor(name,types),_processNoise(processNoise),_measurementNoise(measurementNoise)
+	{
+	}
+
+	Node* KalmanFilterProcessor::clone(string cloneName) const
+	{
+		return copyRestrictions(new KalmanFilterProcessor(cloneName,_types,_processNoise,_measurementNoise));
+	}
+
+	void KalmanFilterProcessor::filterBatch(PointBatch3D& batch,FilterState& state,float dt)
+	{
+		size_t size = batch.size();
+		float q = _processNoise;
+		float r = _measurementNoise;
+		for(int c = 0;c < 3;c++)
+		{
+			float* values = batch.coordinate(c);
+			float* position = state.get(0,c);
+			float* velocity = state.get(1,c);
+			float* p00 = state.get(2,c);
+			float* p01 = state.get(3,c);
+			float* p11 = state.get(4,c);
+
+			if(state.count == 0)
+			{
+				for(size_t i = 0;i < size;i++)
+				{
+					position[i] = values[i];
+					velocity[i] = 0.0f;
+					p00[i] = r;
+					p01[i] = 0.0f;
+					p11[i] = 1.0f;
+				}
+				continue;
+			}
+
+			for(size_t i = 0;i < size;i++)
+			{
+				// Prediction
+				float predicted = position[i] + velocity[i]*dt;
+				float a00 = p00[i] + dt*(2.0f*p01[i] + dt*p11[i]) + q*dt*dt*dt/3.0f;
+				float a01 = p01[i] + dt*p11[i] + q*dt*dt/2.0f;
+				float a11 = p11[i] + q*dt;
+
+				// Correction
+				float innovation = values[i] - predicted;
+				float k0 = a00/(a00 + r);
+				float k1 = a01/(a00 + r);
+				position[i] = predicted + k0*innovation;
+				velocity[i] += k1*innovation;
+				p00[i] = (1.0f - k0)*a00;
+				p01[i] = (1.0f - k0)*a01;
+				p11[i] = a11 - k1*a01;
+				values[i] = position[i];
+			}
+		}
+	}
+
+	MovingAverageProcessor::MovingAverageProcessor(string name,const set<string>& types,int window) : FilterProcessor(name,types),_window((window > 0) ? window : 1)
+	{
+	}
+
+	Node* MovingAverageProcessor::clone(string cloneName) const
+	{
+		return copyRestrictions(new MovingAverageProcessor(cloneName,_types,_window));
+	}
+
+	void MovingAverageProcessor::filterBatch(PointBatch3D& batch,FilterState& state,float /*dt*/)
+	{
+		// Value 0 is the sum, values 1 to window are a ring of the last values
+		size_t size = batch.size();
+		int slot = state.count % _window;
+		float used = (float)((state.count + 1 < _window) ? state.count + 1 : _window);
+		for(int c = 0;c < 3;c++)
+		{
+			float* values = batch.coordinate(c);
+			float* sum = state.get(0,c);
+			float* ring = state.get(1 + slot,c);
+			for(size_t i = 0;i < size;i++)
+			{
+				sum[i] += values[i] - ring[i];
+				ring[i] = values[i];
+				values[i] = sum[i]/used;
+			}
+		}
+	}
+
+	SavitzkyGolayProcessor::SavitzkyGolayProcessor(string name,const set<string>& types,int window,int order) : FilterProcessor(name,types),_window((window > 0) ? window : 1),_order(order)
+	{
+		if(_order >= _window) _order = _window - 1;
+		if(_order < 0) _order = 0;
+
+		// Least squares fit of a polynomial on the times -(window-1)..0, evaluated at 0 : weights = A (AtA)^-1 e0
+		int terms = _order + 1;
+		vector<double> normal(terms*(terms + 1),0.0);
+		for(int row = 0;row < terms;row++)
+		{
+			for(int col = 0;col < terms;col++)
+			{
+				for(int i = 0;i < _window;i++)
+					normal[row*(terms + 1) + col] += pow((double)(i - (_window - 1)),row + col);
+			}
+			normal[row*(terms + 1) + terms] = (row == 0) ? 1.0 : 0.0;
+		}
+
+		// Gauss-Jordan elimination with partial pivoting
+		for(int col = 0;col < terms;col++)
+		{
+			int pivot = col;
+			for(int row = col + 1;row < terms;row++)
+				if(fabs(normal[row*(terms + 1) + col]) > fabs(normal[pivot*(terms + 1) + col])) pivot = row;
+			for(int k = 0;k <= terms;k++) swap(normal[col*(terms + 1) + k],normal[pivot*(terms + 1) + k]);
+
+			for(int row = 0;row < terms;row++)
+			{
+				if(row == col) continue;
+				double factor = normal[row*(terms + 1) + col]/normal[col*(terms + 1) + col];
+				for(int k = col;k <= terms;k++) normal[row*(terms + 1) + k] -= factor*normal[col*(terms + 1) + k];
+			}
+		}
+
+		_coefficients.assign(_window,0.0f);
+		for(int i = 0;i < _window;i++)
+		{
+			double weight = 0.0;
+			for(int k = 0;k < terms;k++)
+				weight += pow((double)(i - (_window - 1)),k)*normal[k*(terms + 1) + terms]/normal[k*(terms + 1) + k];
+			_coefficients[i] = (float)weight;
+		}
+	}
+
+	Node* SavitzkyGolayProcessor::clone(string cloneName) const
+	{
+		return copyRestrictions(new SavitzkyGolayProcessor(cloneName,_types,_window,_order));
+	}
+
+	void SavitzkyGolayProcessor::filterBatch(PointBatch3D& batch,FilterState& state,float /*dt*/)
+	{
+		// Values 0 to window-1 are a ring of the last values, the newest at the slot of this update
+		size_t size = batch.size();
+		int slot = state.count % _window;
+		if(_filtered.size() < size) _filtered.resize(size);
+		float* filtered = _filtered.data();
+		for(int c = 0;c < 3;c++)
+		{
+			float* values = batch.coordinate(c);
+			float* ring = state.get(slot,c);
+			for(size_t i = 0;i < size;i++) ring[i] = values[i];
+
+			// Not enough values for fitting the polynomial yet
+			if(state.count + 1 < _window) continue;
+
+			for(size_t i = 0;i < size;i++) filtered[i] = 0.0f;
+			for(int k = 0;k < _window;k++)
+			{
+				float weight = _coefficients[k];
+				float* past = state.get((slot + 1 + k) % _window,c);
+				for(size_t i = 0;i < size;i++) filtered[i] += weight*past[i];
+			}
+			for(size_t i = 0;i < size;i++) values[i] = filtered[i];
+		}
+	}
+}
@@ -0,0 +1,336 @@
+#include "LgLeapCapture.h"
+
+#include <string.h>
+
+#if defined _WIN32  || defined _WIN64
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef LG_WITH_LEAP
+#include "Leap.h"
+#endif
+
+namespace lg
+{
+	static const char captureMagic[8] = {'L','G','L','E','A','P','C','P'};
+	static const uint32_t captureVersion = 1;
+	static const size_t captureHeaderSize = 16;
+
+	// A hand as stored in a record of LG_LEAP_CAPTURE_HANDS (after a uint32 number of hands)
+	struct CapturedHand
+	{
+		int32_t id;
+		int32_t right;
+		float confidence;
+		float joints[LG_LEAP_JOINT_COUNT][6];
+	};
+
+	static inline size_t paddedLength(size_t length)
+	{
+		return (length + 7) & ~(size_t)7;
+	}
+
+	bool LeapCaptureWriter::open(const string& path)
+	{
+		close();
+		_file = fopen(path.c_str(),"wb");
+		if(_file == 0) return false;
+
+		unsigned char header[captureHeaderSize] = {0};
+		memcpy(header,captureMagic,sizeof(captureMagic));
+		memcpy(header + 8,&captureVersion,sizeof(captureVersion));
+		if(fwrite(header,1,sizeof(header),_file) == sizeof(header)) return true;
+
+		close();
+		return false;
+	}
+
+	void LeapCaptureWriter::close()
+	{
+		if(_file == 0) return;
+		fclose(_file);
+		_file = 0;
+	}
+
+	bool LeapCaptureWriter::writeRecord(uint32_t kind,int64_t frameID,int32_t timestamp,const void* payload,uint32_t length)
+	{
+		if(_file == 0) return false;
+
+		LeapCaptureRecord record;
+		record.length = length;
+		record.kind = kind;
+		record.frameID = frameID;
+		record.timestamp = timestamp;
+		record.reserved = 0;
+
+		static const unsigned char padding[8] = {0};
+		size_t paddingLength = paddedLength(length) - length;
+		return ((fwrite(&record,sizeof(record),1,_file) == 1)&&(fwrite(payload,1,length,_file) == length)&&(fwrite(padding,1,paddingLength,_file) == paddingLength));
+	}
+
+	bool LeapCaptureWriter::writeHands(int64_t frameID,int32_t timestamp,const vector<LeapHandSample>& hands)
+	{
+		uint32_t count = (uint32_t)hands.size();
+		_buffer.resize(sizeof(count) + count*sizeof(CapturedHand));
+		memcpy(&_buffer[0],&count,sizeof(count));
+
+		for(uint32_t i = 0;i < count;i++)
+		{
+			CapturedHand hand;
+			hand.id = hands[i].id;
+			hand.right = hands[i].right ? 1 : 0;
+			hand.confidence = hands[i].confidence;
+			for(int joint = 0;joint < LG_LEAP_JOINT_COUNT;joint++)
+			{
+				const Point3D& position = hands[i].positions[joint];
+				const Point3D& orientation = hands[i].orientations[joint];
+				float values[6] = {position.getX(),position.getY(),position.getZ(),orientation.getX(),orientation.getY(),orientation.getZ()};
+				memcpy(hand.joints[joint],values,sizeof(values));
+			}
+			memcpy(&_buffer[sizeof(count) + i*sizeof(CapturedHand)],&hand,sizeof(hand));
+		}
+		return writeRecord(LG_LEAP_CAPTURE_HANDS,frameID,timestamp,&_buffer[0],(uint32_t)_buffer.size());
+	}
+
+#ifdef LG_WITH_LEAP
+	bool LeapCaptureWriter::writeFrame(const Leap::Frame& frame,int32_t timestamp)
+	{
+		string serialized = frame.serialize();
+		return writeRecord(LG_LEAP_CAPTURE_FRAME,(int64_t)frame.id(),timestamp,serialized.data(),(uint32_t)serialized.size());
+	}
+#endif
+
+	bool LeapCaptureFile::open(const string& path)
+	{
+		close();
+
+#if defined _WIN32  || defined _WIN64
+		FILE* file = fopen(path.c_str(),"rb");
+		if(file == 0)
+		{
+			_error = "libGina : Error : cannot open capture " + path + ".";
+			return false;
+		}
+		fseek(file,0,SEEK_END);
+		long size = ftell(file);
+		fseek(file,0,SEEK_SET);
+		unsigned char* data = (size > 0) ? new unsigned char[size] : 0;
+		if((size <= 0)||(fread(data,1,size,file) != (size_t)size))
+		{
+			delete[] data;
+			fclose(file);
+			_error = "libGina : Error : cannot read capture " + path + ".";
+			return false;
+		}
+		fclose(file);
+		_data = data;
+		_size = (size_t)size;
+		_mapped = false;
+#else
+		int descriptor = ::open(path.c_str(),O_RDONLY);
+		if(descriptor < 0)
+		{
+			_error = "libGina : Error : cannot open capture " + path + ".";
+			return false;
+		}
+		struct stat status;
+		void* data = MAP_FAILED;
+		if((fstat(descriptor,&status) == 0)&&(status.st_size > 0)) data = mmap(0,status.st_size,PROT_READ,MAP_PRIVATE,descriptor,0);
+		::close(descriptor);
+		if(data == MAP_FAILED)
+		{
+			_error = "libGina : Error : cannot map capture " + path + ".";
+			return false;
+		}
+		_data = (const unsigned char*)data;
+		_size = (size_t)status.st_size;
+		_mapped = true;
+#endif
+
+		uint32_t version = 0;
+		if(_size >= captureHeaderSize) memcpy(&version,_data + 8,sizeof(version));
+		if((_size < captureHeaderSize)||(memcmp(_data,captureMagic,sizeof(captureMagic)) != 0)||(version != captureVersion))
+		{
+			close();
+			_error = "libGina : Error : " + path + " is not a capture of this version.";
+			return false;
+		}
+
+		// Index the records (a record truncated by an interrupted capture is ignored)
+		size_t offset = captureHeaderSize;
+		while(offset + sizeof(LeapCaptureRecord) <= _size)
+		{
+			const LeapCaptureRecord* record = reinterpret_cast<const LeapCaptureRecord*>(_data + offset);
+			size_t next = offset + sizeof(LeapCaptureRecord) + paddedLength(record->length);
+			if(next > _size) break;
+			_offsets.push_back(offset);
+			offset = next;
+		}
+		return true;
+	}
+
+	void LeapCaptureFile::close()
+	{
+		if(_data != 0)
+		{
+#if defined _WIN32  || defined _WIN64
+			delete[] _data;
+#else
+			if(_mapped) munmap((void*)_data,_size);
+			else delete[] _data;
+#endif
+		}
+		_data = 0;
+		_size = 0;
+		_mapped = false;
+		_offsets.clear();
+	}
+
+	bool LeapCaptureFile::decodeHands(const LeapCaptureRecord* record,vector<LeapHandSample>& hands)
+	{
+		uint32_t count = 0;
+		if((record->kind != LG_LEAP_CAPTURE_HANDS)||(record->length < sizeof(count))) return false;
+		memcpy(&count,record->getPayload(),sizeof(count));
+		if(record->length < sizeof(count) + count*sizeof(CapturedHand)) return false;
+
+		hands.resize(count);
+		const unsigned char* payload = record->getPayload() + sizeof(count);
+		for(uint32_t i = 0;i < count;i++)
+		{
+			CapturedHand hand;
+			memcpy(&hand,payload + i*sizeof(CapturedHand),sizeof(hand));
+			hands[i].id = hand.id;
+			hands[i].right = (hand.right != 0);
+			hands[i].confidence = hand.confidence;
+			for(int joint = 0;joint < LG_LEAP_JOINT_COUNT;joint++)
+			{
+				const float* values = hand.joints[joint];
+				hands[i].positions[joint] = Point3D(values[0],values[1],values[2]);
+				hands[i].orientations[joint] = Point3D(values[3],values[4],values[5]);
+			}
+		}
+		return true;
+	}
+
+	LeapReplaySource::LeapReplaySource(string path,bool realTime,bool loop) : _path(path),_realTime(realTime),_loop(loop),_next(0),_loops(0),_timer("ms"),_loopStart(0)
+	{
+#ifdef LG_WITH_LEAP
+		_frame = 0;
+		_controller = 0;
+#endif
+	}
+
+	LeapReplaySource::~LeapReplaySource(void)
+	{
+		close();
+	}
+
+	bool LeapReplaySource::open()
+	{
+		if(!_file.open(_path)) return false;
+		_next = 0;
+		_loops = 0;
+		_loopStart = 0;
+		_timer.start();
+		return true;
+	}
+
+	void LeapReplaySource::close()
+	{
+		_file.close();
+#ifdef LG_WITH_LEAP
+		delete _frame;
+		_frame = 0;
+		delete _controller;
+		_controller = 0;
+#endif
+	}
+
+	bool LeapReplaySource::decode(const LeapCaptureRecord* record,vector<LeapHandSample>& hands)
+	{
+		if(record->kind == LG_LEAP_CAPTURE_HANDS) return LeapCaptureFile::decodeHands(record,hands);
+
+#ifdef LG_WITH_LEAP
+		if(record->kind == LG_LEAP_CAPTURE_FRAME)
+		{
+			// Deserializing needs a Controller, which does not need to be connected
+			if(_controller == 0) _controller = new Leap::Controller();
+			if(_frame == 0) _frame = new Leap::Frame();
+
+			// Read in place from the mapping (the std::string version would copy the payload)
+			_frame->deserialize(record->getPayload(),(int)record->length);
+			const Leap::HandList handList = _frame->hands();
+			hands.resize(handList.count());
+			for(int i = 0;i < handList.count();i++) convertLeapHand(handList[i],hands[i]);
+			return true;
+		}
+#endif
+		return false;
+	}
+
+	bool LeapReplaySource::poll(long long& frameID,vector<LeapHandSample>& hands)
+	{
+		size_t count = _file.getRecordCount();
+		if(count == 0) return false;
+
+		if(_next >= count)
+		{
+			if(!_loop) return false;
+			_next = 0;
+			_loops++;
+			_loopStart = _timer.getTimeFromStart();
+		}
+
+		size_t index = _next;
+		if(_realTime)
+		{
+			// Last record whose time has come
+			int elapsed = _timer.getTimeFromStart() - _loopStart;
+			int first = _file.getRecord(0)->timestamp;
+			if(_file.getRecord(index)->timestamp - first > elapsed) return false;
+			while((index + 1 < count)&&(_file.getRecord(index + 1)->timestamp - first <= elapsed)) index++;
+		}
+		_next = index + 1;
+
+		const LeapCaptureRecord* record = _file.getRecord(index);
+		if(!decode(record,hands)) return false;
+
+		// Ids stay increasing when looping
+		frameID = record->frameID + (long long)_loops*(_file.getRecord(count - 1)->frameID + 1);
+		return true;
+	}
+
+	LeapFrameSource* LeapReplaySource::clone() const
+	{
+		return new LeapReplaySource(_path,_realTime,_loop);
+	}
+
+	bool LeapRecordingSource::open()
+	{
+		if(!_source->open()) return false;
+		_timer.start();
+		return _writer.open(_path);
+	}
+
+	void LeapRecordingSource::close()
+	{
+		_source->close();
+		_writer.close();
+	}
+
+	bool LeapRecordingSource::poll(long long& frameID,vector<LeapHandSample>& hands)
+	{
+		if(!_source->poll(frameID,hands)) return false;
+		_writer.writeHands(frameID,_timer.getTimeFromStart(),hands);
+		return true;
+	}
+
+	LeapFrameSource* LeapRecordingSource::clone() const
+	{
+		return new LeapRecordingSource(_source->clone(),_path);
+	}
+}
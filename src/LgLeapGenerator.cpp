@@ -0,0 +1,253 @@
+#include "LgLeapGenerator.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#ifdef LG_WITH_LEAP
+#include "Leap.h"
+#include "LgLeapMath.h"
+#endif
+
+namespace lg
+{
+	// Types of the joints, by side (0 left, 1 right) then by joint
+	static const string jointTypes[2][LG_LEAP_JOINT_COUNT] = {
+		{LG_ORIENTEDPOINT3D_LEFT_HAND,LG_ORIENTEDPOINT3D_LEFT_WRIST,LG_ORIENTEDPOINT3D_LEFT_ELBOW,LG_ORIENTEDPOINT3D_LEFT_THUMB,
+		 LG_ORIENTEDPOINT3D_LEFT_INDEX,LG_ORIENTEDPOINT3D_LEFT_MIDDLE,LG_ORIENTEDPOINT3D_LEFT_RING,LG_ORIENTEDPOINT3D_LEFT_PINKY},
+		{LG_ORIENTEDPOINT3D_RIGHT_HAND,LG_ORIENTEDPOINT3D_RIGHT_WRIST,LG_ORIENTEDPOINT3D_RIGHT_ELBOW,LG_ORIENTEDPOINT3D_RIGHT_THUMB,
+		 LG_ORIENTEDPOINT3D_RIGHT_INDEX,LG_ORIENTEDPOINT3D_RIGHT_MIDDLE,LG_ORIENTEDPOINT3D_RIGHT_RING,LG_ORIENTEDPOINT3D_RIGHT_PINKY}};
+
+	static const string groupPrefix = "LEAP_HAND_";
+
+	bool MockLeapSource::open()
+	{
+		_frame = 0;
+		return true;
+	}
+
+	void MockLeapSource::close()
+	{
+	}
+
+	bool MockLeapSource::poll(long long& frameID,vector<LeapHandSample>& hands)
+	{
+		frameID = ++_frame;
+		if(!_frames.empty())
+		{
+			hands = _frames.front();
+			_frames.pop_front();
+			return true;
+		}
+
+		// Hands moving on circles of 50 mm, 200 mm above the device, at 200 frames per second
+		hands.resize((_handCount > 2) ? 2 : ((_handCount < 0) ? 0 : _handCount));
+		float angle = 0.005f*(float)_frame;
+		for(size_t i = 0;i < hands.size();i++)
+		{
+			LeapHandSample& hand = hands[i];
+			hand.id = (int)i + 1;
+			hand.right = (i == 0);
+			hand.confidence = 1.0f;
+
+			float side = hand.right ? 1.0f : -1.0f;
+			Point3D palm(side*100.0f + 50.0f*cosf(angle),200.0f,50.0f*sinf(angle));
+			Point3D orientation(0.0f,side*angle,0.0f);
+			hand.positions[LG_LEAP_JOINT_PALM] = palm;
+			hand.positions[LG_LEAP_JOINT_WRIST] = Point3D(palm.getX(),palm.getY(),palm.getZ() + 50.0f);
+			hand.positions[LG_LEAP_JOINT_ELBOW] = Point3D(palm.getX() + side*50.0f,palm.getY() - 50.0f,palm.getZ() + 250.0f);
+			for(int finger = 0;finger < 5;finger++)
+				hand.positions[LG_LEAP_JOINT_THUMB + finger] = Point3D(palm.getX() + side*20.0f*(float)(finger - 2),palm.getY(),palm.getZ() - ((finger == 0) ? 40.0f : 80.0f));
+			for(int joint = 0;joint < LG_LEAP_JOINT_COUNT;joint++) hand.orientations[joint] = orientation;
+		}
+		return true;
+	}
+
+	LeapFrameSource* MockLeapSource::clone() const
+	{
+		return new MockLeapSource(_handCount);
+	}
+
+#ifdef LG_WITH_LEAP
+	void convertLeapHand(const Leap::Hand& hand,LeapHandSample& sample)
+	{
+		sample.id = hand.id();
+		sample.right = hand.isRight();
+		sample.confidence = hand.confidence();
+
+		Leap::Vector positions[LG_LEAP_JOINT_COUNT];
+		Leap::Matrix bases[LG_LEAP_JOINT_COUNT];
+		positions[LG_LEAP_JOINT_PALM] = hand.palmPosition();
+		bases[LG_LEAP_JOINT_PALM] = hand.basis();
+
+		const Leap::Arm arm = hand.arm();
+		positions[LG_LEAP_JOINT_WRIST] = arm.wristPosition();
+		positions[LG_LEAP_JOINT_ELBOW] = arm.elbowPosition();
+		bases[LG_LEAP_JOINT_WRIST] = arm.basis();
+		bases[LG_LEAP_JOINT_ELBOW] = bases[LG_LEAP_JOINT_WRIST];
+
+		const Leap::FingerList fingers = hand.fingers();
+		for(int i = 0;i < fingers.count();i++)
+		{
+			const Leap::Finger finger = fingers[i];
+			int joint = LG_LEAP_JOINT_THUMB + (int)finger.type();
+			if((joint < LG_LEAP_JOINT_THUMB)||(joint >= LG_LEAP_JOINT_COUNT)) continue;
+
+			const Leap::Bone distal = finger.bone(Leap::Bone::TYPE_DISTAL);
+			positions[joint] = distal.nextJoint();
+			bases[joint] = distal.basis();
+		}
+
+		// Missing fingers keep a null position and orientation
+		toPoint3D(positions,LG_LEAP_JOINT_COUNT,sample.positions);
+		toEulerAngles(bases,LG_LEAP_JOINT_COUNT,sample.orientations);
+	}
+
+	bool LeapControllerSource::open()
+	{
+		if(_controller == 0) _controller = new Leap::Controller();
+		_lastFrame = -1;
+		return true;
+	}
+
+	void LeapControllerSource::close()
+	{
+		delete _controller;
+		_controller = 0;
+	}
+
+	bool LeapControllerSource::poll(long long& frameID,vector<LeapHandSample>& hands)
+	{
+		if((_controller == 0)||(!_controller->isConnected())) return false;
+
+		const Leap::Frame frame = _controller->frame();
+		if((!frame.isValid())||((long long)frame.id() == _lastFrame)) return false;
+		_lastFrame = (long long)frame.id();
+		frameID = _lastFrame;
+
+		const Leap::HandList handList = frame.hands();
+		hands.resize(handList.count());
+		for(int i = 0;i < handList.count();i++) convertLeapHand(handList[i],hands[i]);
+		return true;
+	}
+
+	LeapFrameSource* LeapControllerSource::clone() const
+	{
+		return new LeapControllerSource();
+	}
+#endif
+
+	LeapGenerator::LeapGenerator(string name,LeapFrameSource* source) : Generator(name),_source(source),_lastFrame(-1)
+	{
+		if(_source == 0) _source = new MockLeapSource();
+		for(int side = 0;side < 2;side++)
+			for(int joint = 0;joint < LG_LEAP_JOINT_COUNT;joint++) _generatedJoints[side][joint] = true;
+	}
+
+	LeapGenerator::~LeapGenerator(void)
+	{
+		delete _source;
+	}
+
+	const string& LeapGenerator::getJointType(int joint,bool right)
+	{
+		return jointTypes[right ? 1 : 0][joint];
+	}
+
+	bool LeapGenerator::generates(const string& type) const
+	{
+		if(_generatedType.empty()) return true;
+		map<string,bool>::const_iterator git = _generatedType.find(type);
+		return ((git != _generatedType.end())&&(git->second));
+	}
+
+	Node* LeapGenerator::clone(string cloneName) const
+	{
+		LeapGenerator* clone = new LeapGenerator(cloneName,_source->clone());
+		for(map<string,bool>::const_iterator git = _generatedType.begin();git != _generatedType.end();git++)
+			if(git->second) clone->onlyGenerate(git->first);
+		return clone;
+	}
+
+	bool LeapGenerator::start()
+	{
+		for(int side = 0;side < 2;side++)
+			for(int joint = 0;joint < LG_LEAP_JOINT_COUNT;joint++) _generatedJoints[side][joint] = generates(jointTypes[side][joint]);
+		_lastFrame = -1;
+		return _source->open();
+	}
+
+	bool LeapGenerator::stop()
+	{
+		_source->close();
+		return true;
+	}
+
+	bool LeapGenerator::generate(map<string,Group3D*>& groups3D,map<string,Group2D*>&,map<string,Group1D*>&,map<string,GroupSwitch*>&)
+	{
+		long long frameID;
+		if((!_source->poll(frameID,_hands))||(frameID == _lastFrame)) return true;
+		_lastFrame = frameID;
+
+		// Hands which left the field of view
+		map<int, string>::iterator nit = _groupNames.begin();
+		while(nit != _groupNames.end())
+		{
+			bool seen = false;
+			for(size_t i = 0;(i < _hands.size())&&(!seen);i++) seen = (_hands[i].id == nit->first);
+			if(seen)
+			{
+				nit++;
+				continue;
+			}
+
+			map<string,Group3D*>::iterator git = groups3D.find(nit->second);
+			if(git != groups3D.end())
+			{
+				delete git->second;
+				groups3D.erase(git);
+			}
+			_groupNames.erase(nit++);
+		}
+
+		for(size_t i = 0;i < _hands.size();i++)
+		{
+			const LeapHandSample& hand = _hands[i];
+
+			nit = _groupNames.find(hand.id);
+			if(nit == _groupNames.end())
+			{
+				char buffer[16];
+				snprintf(buffer,sizeof(buffer),"%d",hand.id);
+				nit = _groupNames.insert(make_pair(hand.id,groupPrefix + buffer)).first;
+			}
+
+			Group3D*& group = groups3D[nit->second];
+			if(group == 0) group = new Group3D(_environment,nit->second,LG_GROUP_3D);
+
+			int side = hand.right ? 1 : 0;
+			for(int joint = 0;joint < LG_LEAP_JOINT_COUNT;joint++)
+			{
+				if(!_generatedJoints[side][joint]) continue;
+
+				const string& type = jointTypes[side][joint];
+				HOrientedPoint3D* historic = group->getElementByID(type);
+				if(historic == 0)
+				{
+					historic = new HOrientedPoint3D(_environment,type,type);
+					group->addElement(type,historic);
+				}
+				historic->updateHistoric(_timestamp,OrientedPoint3D(hand.positions[joint],hand.orientations[joint],hand.confidence,1.0f));
+			}
+		}
+		return true;
+	}
+
+	set<string> LeapGenerator::produce() const
+	{
+		set<string> produce;
+		for(int side = 0;side < 2;side++)
+			for(int joint = 0;joint < LG_LEAP_JOINT_COUNT;joint++)
+				if(generates(jointTypes[side][joint])) produce.insert(jointTypes[side][joint]);
+		return produce;
+	}
+}
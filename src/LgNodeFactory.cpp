@@ -0,0 +1,252 @@
+#include "LgNodeFactory.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#if defined _WIN32  || defined _WIN64
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace lg
+{
+	map<string,LibraryHandle> NodeFactory::_instances;
+	map<string,Node*> NodeFactory::_nodes;
+	map<string,create_t*> NodeFactory::_factories;
+	map<string,pair<LibraryHandle,int> > NodeFactory::_libraries;
+	map<string,string> NodeFactory::_paths;
+	int NodeFactory::_cloneCounter = 0;
+	string NodeFactory::_error;
+
+	static LibraryHandle openLibrary(const string& path)
+	{
+#if defined _WIN32  || defined _WIN64
+		return LoadLibraryA(path.c_str());
+#else
+		return dlopen(path.c_str(),RTLD_NOW|RTLD_LOCAL);
+#endif
+	}
+
+	static void closeLibrary(LibraryHandle library)
+	{
+#if defined _WIN32  || defined _WIN64
+		FreeLibrary(library);
+#else
+		dlclose(library);
+#endif
+	}
+
+	static create_t* findFactory(LibraryHandle library)
+	{
+#if defined _WIN32  || defined _WIN64
+		return (create_t*)GetProcAddress(library,LG_NODE_FACTORY_SYMBOL);
+#else
+		return (create_t*)dlsym(library,LG_NODE_FACTORY_SYMBOL);
+#endif
+	}
+
+	static string libraryError()
+	{
+#if defined _WIN32  || defined _WIN64
+		char buffer[32];
+		snprintf(buffer,sizeof(buffer),"error %lu",(unsigned long)GetLastError());
+		return buffer;
+#else
+		const char* error = dlerror();
+		return (error == 0) ? string("unknown error") : string(error);
+#endif
+	}
+
+	static string trim(const string& text)
+	{
+		size_t first = text.find_first_not_of(" \t\r\n");
+		if(first == string::npos) return string();
+		size_t last = text.find_last_not_of(" \t\r\n");
+		return text.substr(first,last - first + 1);
+	}
+
+	// Add the extension of the platform to a path without extension
+	static string getLibraryPath(const string& filePath)
+	{
+		string path = filePath;
+		size_t separator = path.find_last_of("/\\");
+		if(path.find('.',(separator == string::npos) ? 0 : separator + 1) == string::npos) path += EXTENSION;
+		return path;
+	}
+
+	// Start reading a file in the background, so it is in memory when loaded
+	static void prefetchLibrary(const string& path)
+	{
+#if defined _WIN32  || defined _WIN64
+		(void)path;
+#else
+		int descriptor = open(path.c_str(),O_RDONLY);
+		if(descriptor < 0) return;
+		posix_fadvise(descriptor,0,0,POSIX_FADV_WILLNEED);
+		close(descriptor);
+#endif
+	}
+
+	void NodeFactory::registerNode(const string& genericNodeName,Node* node)
+	{
+		unregister(genericNodeName);
+		_nodes[genericNodeName] = node;
+	}
+
+	bool NodeFactory::registerNodeFromFile(const string& genericNodeName,const string& filePath)
+	{
+		string path = getLibraryPath(filePath);
+		map<string,pair<LibraryHandle,int> >::iterator lit = _libraries.find(path);
+		LibraryHandle library = (lit == _libraries.end()) ? openLibrary(path) : lit->second.first;
+		if(library == 0)
+		{
+			_error = "libGina : Error : cannot load " + path + " (" + libraryError() + ").";
+			return false;
+		}
+
+		create_t* factory = findFactory(library);
+		if(factory == 0)
+		{
+			_error = "libGina : Error : " + path + " does not declare the function " + LG_NODE_FACTORY_SYMBOL + ".";
+			if(lit == _libraries.end()) closeLibrary(library);
+			return false;
+		}
+
+		// Keep the file loaded while replacing a Node registered from it under the same name
+		if(lit == _libraries.end()) lit = _libraries.insert(make_pair(path,make_pair(library,0))).first;
+		lit->second.second++;
+		unregister(genericNodeName);
+
+		_instances[genericNodeName] = library;
+		_factories[genericNodeName] = factory;
+		_paths[genericNodeName] = path;
+		return true;
+	}
+
+	bool NodeFactory::registerNodesFromFiles(const vector<pair<string,string> >& files)
+	{
+		// The system loads the files one at a time (glibc holds a lock during dlopen, and during the static initializations of the file) :
+		// all the files are read concurrently by the system before, so loading them does not wait for the disk
+		vector<string> paths;
+		for(vector<pair<string,string> >::const_iterator fit = files.begin();fit != files.end();fit++)
+		{
+			string path = getLibraryPath(fit->second);
+			if((_libraries.count(path) == 0)&&(find(paths.begin(),paths.end(),path) == paths.end())) paths.push_back(path);
+		}
+		for(vector<string>::iterator pit = paths.begin();pit != paths.end();pit++) prefetchLibrary(*pit);
+
+		bool success = true;
+		string errors;
+		for(vector<pair<string,string> >::const_iterator fit = files.begin();fit != files.end();fit++)
+		{
+			if(registerNodeFromFile(fit->first,fit->second)) continue;
+			errors += " " + _error;
+			success = false;
+		}
+
+		if(!success) _error = trim(errors);
+		return success;
+	}
+
+	bool NodeFactory::registerNodesFromConfig(const string& configPath)
+	{
+		ifstream config(configPath.c_str());
+		if(!config.is_open())
+		{
+			_error = "libGina : Error : cannot open " + configPath + ".";
+			return false;
+		}
+
+		// Paths are relative to the configuration file
+		size_t separator = configPath.find_last_of("/\\");
+		string directory = (separator == string::npos) ? string() : configPath.substr(0,separator + 1);
+
+		bool success = true;
+		string errors;
+		vector<pair<string,string> > entries;
+		string line;
+		int number = 0;
+		while(getline(config,line))
+		{
+			number++;
+			line = trim(line);
+			if((line.empty())||(line[0] == '#')||(line[0] == ';')) continue;
+
+			size_t equal = line.find('=');
+			string name = (equal == string::npos) ? string() : trim(line.substr(0,equal));
+			string path = (equal == string::npos) ? string() : trim(line.substr(equal + 1));
+			if((name.empty())||(path.empty()))
+			{
+				char buffer[32];
+				snprintf(buffer,sizeof(buffer),"%d",number);
+				errors += " libGina : Error : " + configPath + ":" + buffer + " is not \"name = path\".";
+				success = false;
+				continue;
+			}
+
+			bool absolute = ((path[0] == '/')||(path[0] == '\\')||((path.size() > 1)&&(path[1] == ':')));
+			entries.push_back(make_pair(name,absolute ? path : directory + path));
+		}
+
+		if(!registerNodesFromFiles(entries))
+		{
+			errors += " " + _error;
+			success = false;
+		}
+
+		if(!success) _error = trim(errors);
+		return success;
+	}
+
+	void NodeFactory::unregister(const string& genericNodeName)
+	{
+		_nodes.erase(genericNodeName);
+		_factories.erase(genericNodeName);
+		_instances.erase(genericNodeName);
+
+		map<string,string>::iterator pit = _paths.find(genericNodeName);
+		if(pit == _paths.end()) return;
+
+		map<string,pair<LibraryHandle,int> >::iterator lit = _libraries.find(pit->second);
+		_paths.erase(pit);
+		if((lit == _libraries.end())||(--lit->second.second > 0)) return;
+		closeLibrary(lit->second.first);
+		_libraries.erase(lit);
+	}
+
+	bool NodeFactory::isRegistered(const string& genericNodeName)
+	{
+		return ((_factories.count(genericNodeName) > 0)||(_nodes.count(genericNodeName) > 0));
+	}
+
+	Node* NodeFactory::create(const string& genericNodeName)
+	{
+		map<string,create_t*>::iterator fit = _factories.find(genericNodeName);
+		if(fit != _factories.end()) return fit->second();
+
+		map<string,Node*>::iterator nit = _nodes.find(genericNodeName);
+		if(nit == _nodes.end())
+		{
+			_error = "libGina : Error : " + genericNodeName + " is not registered in the node factory.";
+			return 0;
+		}
+
+		char buffer[16];
+		snprintf(buffer,sizeof(buffer),"_%d",++_cloneCounter);
+		Node* clone = nit->second->clone(genericNodeName + buffer);
+		if((clone != 0)&&(clone != nit->second)) return clone;
+
+		// Giving the registered instance would share it between all the callers
+		_error = "libGina : Error : " + genericNodeName + " cannot be cloned.";
+		return 0;
+	}
+
+	string NodeFactory::getLastError()
+	{
+		return _error;
+	}
+}
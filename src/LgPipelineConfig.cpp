@@ -0,0 +1,394 @@
+#include "LgPipelineConfig.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <fstream>
+
+#if defined __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "LgEnvironment.h"
+#include "LgNodeFactory.h"
+#include "LgObserver.h"
+#include "LgProcessor.h"
+
+namespace lg
+{
+	// Settings of the [environment] and [scheduler] sections, and whether they are booleans
+	static const char* booleanSettings[] = {"dataCopy","runtimeChanges","dirtyTracking","processorFusion","parallelStart","inputSkipping","cycleRejection"};
+	static const char* integerSettings[] = {"historicLength","tryNumber"};
+
+	// Filters of the Processors, then of the Observers
+	static const char* processorFilters[] = {"onlyProcessGroupIDs","onlyProcessGroupType","onlyProcessPointType","ignoreGroupIDs","ignoreGroupType","ignorePointType"};
+	static const char* observerFilters[] = {"onlyObserveGroupIDs","onlyObserveGroupType","onlyObservePointType","ignoreGroupIDs","ignoreGroupType","ignorePointType"};
+
+	static bool contains(const char* const* names,size_t count,const string& name)
+	{
+		for(size_t i = 0;i < count;i++)
+			if(name == names[i]) return true;
+		return false;
+	}
+
+	static string trim(const string& text)
+	{
+		size_t first = text.find_first_not_of(" \t\r\n");
+		if(first == string::npos) return string();
+		size_t last = text.find_last_not_of(" \t\r\n");
+		return text.substr(first,last - first + 1);
+	}
+
+	static vector<string> split(const string& text)
+	{
+		vector<string> values;
+		size_t first = text.find_first_not_of(" \t,");
+		while(first != string::npos)
+		{
+			size_t last = text.find_first_of(" \t,",first);
+			values.push_back(text.substr(first,(last == string::npos) ? string::npos : last - first));
+			first = (last == string::npos) ? string::npos : text.find_first_not_of(" \t,",last);
+		}
+		return values;
+	}
+
+	static bool parseBoolean(const string& text,int& value)
+	{
+		if((text == "true")||(text == "yes")||(text == "on")||(text == "1")) value = 1;
+		else if((text == "false")||(text == "no")||(text == "off")||(text == "0")) value = 0;
+		else return false;
+		return true;
+	}
+
+	static bool parseInteger(const string& text,int& value)
+	{
+		char* end = 0;
+		long parsed = strtol(text.c_str(),&end,10);
+		if((text.empty())||(*end != '\0')) return false;
+		value = (int)parsed;
+		return true;
+	}
+
+	static bool parseFloat(const string& text,float& value)
+	{
+		char* end = 0;
+		double parsed = strtod(text.c_str(),&end);
+		if((text.empty())||(*end != '\0')) return false;
+		value = (float)parsed;
+		return true;
+	}
+
+	static bool parseChannels(const string& text,int& channels)
+	{
+		vector<string> names = split(text);
+		channels = 0;
+		for(vector<string>::iterator it = names.begin();it != names.end();it++)
+		{
+			if(*it == "3D") channels |= LG_CHANNEL_3D;
+			else if(*it == "2D") channels |= LG_CHANNEL_2D;
+			else if(*it == "1D") channels |= LG_CHANNEL_1D;
+			else if(*it == "SWITCH") channels |= LG_CHANNEL_SWITCH;
+			else if(*it == "ALL") channels |= LG_CHANNEL_ALL;
+			else return false;
+		}
+		return !names.empty();
+	}
+
+	bool PipelineConfig::parseEntry(const string& section,const string& key,const string& value,int line)
+	{
+		char number[16];
+		snprintf(number,sizeof(number),"%d",line);
+		string where = _path + ":" + number;
+
+		if((section == "environment")||(section == "scheduler"))
+		{
+			int setting;
+			if((section == "scheduler")&&(key == "affinity"))
+			{
+				vector<string> cpus = split(value);
+				_affinity.clear();
+				for(vector<string>::iterator it = cpus.begin();it != cpus.end();it++)
+				{
+					if((!parseInteger(*it,setting))||(setting < 0)) break;
+					_affinity.push_back(setting);
+				}
+				if((!cpus.empty())&&(_affinity.size() == cpus.size())) return true;
+			}
+			else if((section == "scheduler")&&(key == "shardThreads"))
+			{
+				// 0 for one thread per core
+				if((parseInteger(value,setting))&&(setting >= 0))
+				{
+					_settings[key] = setting;
+					return true;
+				}
+			}
+			else if(contains(booleanSettings,sizeof(booleanSettings)/sizeof(*booleanSettings),key))
+			{
+				if(((section == "environment") == ((key == "dataCopy")||(key == "runtimeChanges")))&&(parseBoolean(value,setting)))
+				{
+					_settings[key] = setting;
+					return true;
+				}
+			}
+			else if((section == "environment")&&(contains(integerSettings,sizeof(integerSettings)/sizeof(*integerSettings),key)))
+			{
+				if((parseInteger(value,setting))&&(setting > 0))
+				{
+					_settings[key] = setting;
+					return true;
+				}
+			}
+			_error = "libGina : Error : " + where + " : invalid setting " + key + " = " + value + ".";
+			return false;
+		}
+
+		if(section == "plugins")
+		{
+			// Paths are relative to the pipeline file
+			size_t separator = _path.find_last_of("/\\");
+			bool absolute = ((value[0] == '/')||(value[0] == '\\')||((value.size() > 1)&&(value[1] == ':')));
+			_plugins.push_back(make_pair(key,((absolute)||(separator == string::npos)) ? value : _path.substr(0,separator + 1) + value));
+			return true;
+		}
+
+		if(section.compare(0,5,"node ") == 0)
+		{
+			PipelineNode& node = _nodes.back();
+			bool valid = true;
+			if(key == "class") node.genericName = value;
+			else if(key == "priority") valid = ((parseInteger(value,node.priority))&&(node.priority >= 0));
+			else if(key == "channels") valid = parseChannels(value,node.channels);
+			else if(key == "sharded")
+			{
+				int sharded = 0;
+				valid = parseBoolean(value,sharded);
+				node.sharded = (sharded != 0);
+			}
+			else if(key == "lazy")
+			{
+				vector<string> inputs = split(value);
+				node.lazy = true;
+				node.inputs.insert(inputs.begin(),inputs.end());
+			}
+			else if((contains(processorFilters,sizeof(processorFilters)/sizeof(*processorFilters),key))||(contains(observerFilters,sizeof(observerFilters)/sizeof(*observerFilters),key)))
+			{
+				vector<string> arguments = split(value);
+				for(vector<string>::iterator it = arguments.begin();it != arguments.end();it++) node.filters.push_back(make_pair(key,*it));
+			}
+			else valid = false;
+
+			if(!valid) _error = "libGina : Error : " + where + " : invalid node setting " + key + " = " + value + ".";
+			return valid;
+		}
+
+		int integer;
+		float smoothing = 0.1f;
+		vector<string> values = split(value);
+		bool valid = ((!values.empty())&&(parseInteger(values[0],integer))&&(integer >= 0));
+		if((section == "historic")&&(valid)&&(values.size() == 1)) _historicLengths[key] = integer;
+		else if((section == "windows")&&(valid)&&(values.size() == 1)) _historicWindows[key] = integer;
+		else if((section == "freshness")&&(valid)&&(values.size() == 1)) _freshnessBudgets[key] = integer;
+		else if((section == "statistics")&&(valid)&&(integer > 0)&&((values.size() == 1)||((values.size() == 2)&&(parseFloat(values[1],smoothing)))))
+			_statistics[key] = make_pair(integer,smoothing);
+		else
+		{
+			_error = "libGina : Error : " + where + " : invalid value " + key + " = " + value + ".";
+			return false;
+		}
+		return true;
+	}
+
+	bool PipelineConfig::load(const string& path)
+	{
+		_path = path;
+		_settings.clear();
+		_affinity.clear();
+		_plugins.clear();
+		_nodes.clear();
+		_historicLengths.clear();
+		_historicWindows.clear();
+		_freshnessBudgets.clear();
+		_statistics.clear();
+
+		ifstream file(path.c_str());
+		if(!file.is_open())
+		{
+			_error = "libGina : Error : cannot open " + path + ".";
+			return false;
+		}
+
+		string section;
+		string line;
+		int number = 0;
+		set<string> names;
+		while(getline(file,line))
+		{
+			number++;
+			line = trim(line);
+			if((line.empty())||(line[0] == '#')||(line[0] == ';')) continue;
+
+			char buffer[16];
+			snprintf(buffer,sizeof(buffer),"%d",number);
+			if(line[0] == '[')
+			{
+				section = (line[line.size() - 1] == ']') ? trim(line.substr(1,line.size() - 2)) : string();
+				if((section.compare(0,5,"node ") == 0)&&(!trim(section.substr(5)).empty()))
+				{
+					PipelineNode node;
+					node.name = trim(section.substr(5));
+					node.genericName = node.name;
+					node.priority = -1;
+					node.channels = -1;
+					node.lazy = false;
+					node.sharded = false;
+					node.line = number;
+					if(!names.insert(node.name).second)
+					{
+						_error = "libGina : Error : " + path + ":" + buffer + " : node " + node.name + " declared twice.";
+						return false;
+					}
+					_nodes.push_back(node);
+					section = "node " + node.name;
+				}
+				else if((section != "environment")&&(section != "scheduler")&&(section != "plugins")&&(section != "historic")&&(section != "windows")&&(section != "freshness")&&(section != "statistics"))
+				{
+					_error = "libGina : Error : " + path + ":" + buffer + " : unknown section " + line + ".";
+					return false;
+				}
+				continue;
+			}
+
+			size_t equal = line.find('=');
+			string key = (equal == string::npos) ? string() : trim(line.substr(0,equal));
+			string value = (equal == string::npos) ? string() : trim(line.substr(equal + 1));
+			if((section.empty())||(key.empty())||(value.empty()))
+			{
+				_error = "libGina : Error : " + path + ":" + buffer + " is not \"key = value\" in a section.";
+				return false;
+			}
+			if(!parseEntry(section,key,value,number)) return false;
+		}
+
+		// Lazy Nodes are created during the updates, after the filters could be given
+		for(vector<PipelineNode>::iterator it = _nodes.begin();it != _nodes.end();it++)
+		{
+			char buffer[16];
+			snprintf(buffer,sizeof(buffer),"%d",it->line);
+			if((it->lazy)&&((!it->filters.empty())||(it->channels >= 0)||(it->sharded)||(it->inputs.empty())))
+			{
+				_error = "libGina : Error : " + path + ":" + buffer + " : lazy node " + it->name + " needs inputs and cannot have filters, channels or clones.";
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool PipelineConfig::applyFilters(Node* node,const PipelineNode& description)
+	{
+		Processor* processor = dynamic_cast<Processor*>(node);
+		Observer* observer = dynamic_cast<Observer*>(node);
+		for(vector<pair<string,string> >::const_iterator it = description.filters.begin();it != description.filters.end();it++)
+		{
+			const string& filter = it->first;
+			const string& argument = it->second;
+			if((processor != 0)&&(contains(processorFilters,sizeof(processorFilters)/sizeof(*processorFilters),filter)))
+			{
+				if(filter == "onlyProcessGroupIDs") processor->onlyProcessGroupIDs(argument);
+				else if(filter == "onlyProcessGroupType") processor->onlyProcessGroupType(argument);
+				else if(filter == "onlyProcessPointType") processor->onlyProcessPointType(argument);
+				else if(filter == "ignoreGroupIDs") processor->ignoreGroupIDs(argument);
+				else if(filter == "ignoreGroupType") processor->ignoreGroupType(argument);
+				else processor->ignorePointType(argument);
+			}
+			else if((observer != 0)&&(contains(observerFilters,sizeof(observerFilters)/sizeof(*observerFilters),filter)))
+			{
+				if(filter == "onlyObserveGroupIDs") observer->onlyObserveGroupIDs(argument);
+				else if(filter == "onlyObserveGroupType") observer->onlyObserveGroupType(argument);
+				else if(filter == "onlyObservePointType") observer->onlyObservePointType(argument);
+				else if(filter == "ignoreGroupIDs") observer->ignoreGroupIDs(argument);
+				else if(filter == "ignoreGroupType") observer->ignoreGroupType(argument);
+				else observer->ignorePointType(argument);
+			}
+			else
+			{
+				_error = "libGina : Error : " + filter + " is not a filter of the node " + description.name + ".";
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool PipelineConfig::apply(Scheduler* scheduler)
+	{
+		Environment* environment = scheduler->getEnvironment();
+		map<string,int>::iterator sit;
+		if((sit = _settings.find("dataCopy")) != _settings.end()) environment->enableDataCopy(sit->second != 0);
+		if((sit = _settings.find("runtimeChanges")) != _settings.end()) environment->enableRuntimeChanges(sit->second != 0);
+		if((sit = _settings.find("tryNumber")) != _settings.end()) environment->setTryNumber(sit->second);
+		if((sit = _settings.find("historicLength")) != _settings.end()) scheduler->setDefaultHistoricLength(sit->second);
+		if((sit = _settings.find("dirtyTracking")) != _settings.end()) scheduler->enableDirtyTracking(sit->second != 0);
+		if((sit = _settings.find("processorFusion")) != _settings.end()) scheduler->enableProcessorFusion(sit->second != 0);
+		if((sit = _settings.find("parallelStart")) != _settings.end()) scheduler->enableParallelStart(sit->second != 0);
+		if((sit = _settings.find("inputSkipping")) != _settings.end()) scheduler->enableInputSkipping(sit->second != 0);
+		if((sit = _settings.find("cycleRejection")) != _settings.end()) scheduler->enableCycleRejection(sit->second != 0);
+		if((sit = _settings.find("shardThreads")) != _settings.end()) scheduler->setShardThreads(sit->second);
+
+		for(map<string,int>::iterator it = _historicLengths.begin();it != _historicLengths.end();it++) scheduler->setHistoricLength(it->first,it->second);
+		for(map<string,int>::iterator it = _historicWindows.begin();it != _historicWindows.end();it++) scheduler->setHistoricWindow(it->first,it->second);
+		for(map<string,int>::iterator it = _freshnessBudgets.begin();it != _freshnessBudgets.end();it++) scheduler->setFreshnessBudget(it->first,it->second);
+		for(map<string,pair<int,float> >::iterator it = _statistics.begin();it != _statistics.end();it++) scheduler->enableStatistics(it->first,it->second.first,it->second.second);
+
+		if((!_plugins.empty())&&(!NodeFactory::registerNodesFromFiles(_plugins)))
+		{
+			_error = NodeFactory::getLastError();
+			return false;
+		}
+
+		for(vector<PipelineNode>::iterator it = _nodes.begin();it != _nodes.end();it++)
+		{
+			if(it->lazy)
+			{
+				if(scheduler->registerLazyNode(it->genericName,it->inputs,it->priority)) continue;
+				_error = scheduler->getLastError();
+				return false;
+			}
+
+			Node* node = scheduler->createNode(it->genericName,it->name,it->priority);
+			if(node == 0)
+			{
+				_error = scheduler->getLastError();
+				return false;
+			}
+			if(it->channels >= 0) scheduler->setChannels(node,it->channels);
+			if((it->sharded)&&(!scheduler->setSharded(node,true)))
+			{
+				_error = scheduler->getLastError();
+				return false;
+			}
+			if(!applyFilters(node,*it)) return false;
+		}
+
+		if(!_affinity.empty())
+		{
+#if defined __linux__
+			cpu_set_t cpus;
+			CPU_ZERO(&cpus);
+			for(vector<int>::iterator it = _affinity.begin();it != _affinity.end();it++) CPU_SET(*it,&cpus);
+			if(pthread_setaffinity_np(pthread_self(),sizeof(cpus),&cpus) != 0)
+			{
+				_error = "libGina : Error : cannot set the affinity of the thread.";
+				return false;
+			}
+#else
+			_error = "libGina : Error : thread affinity is not supported on this system.";
+			return false;
+#endif
+		}
+
+		if(scheduler->prepare()) return true;
+		_error = scheduler->getLastError();
+		return false;
+	}
+}
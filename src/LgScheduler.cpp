@@ -0,0 +1,1615 @@
+#include "LgScheduler.h"
+
+#include <limits.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "LgFilters.h"
+#include "LgGenerator.h"
+#include "LgNodeFactory.h"
+#include "LgObserver.h"
+#include "LgProcessor.h"
+
+namespace lg
+{
+	// Schedulers created on each Environment
+	static map<Environment*, Scheduler*> schedulers;
+	static mutex schedulersMutex;
+
+	Scheduler* getSchedulerOfEnvironment(Environment* e)
+	{
+		lock_guard<mutex> lock(schedulersMutex);
+		map<Environment*, Scheduler*>::iterator sit = schedulers.find(e);
+		if(sit == schedulers.end()) return 0;
+		return sit->second;
+	}
+
+	// Fingerprints of the values, for noticing a value replaced at the same timestamp
+	static size_t fingerprint(size_t seed,float value)
+	{
+		unsigned int bits;
+		memcpy(&bits,&value,sizeof(bits));
+		return seed ^ (bits + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+	}
+
+	static size_t fingerprint(size_t seed,bool value) {return fingerprint(seed,value ? 1.0f : 0.0f);}
+	static size_t fingerprint(size_t seed,const Point2D& value) {return fingerprint(fingerprint(seed,value.getX()),value.getY());}
+	static size_t fingerprint(size_t seed,const Point3D& value) {return fingerprint(fingerprint(fingerprint(seed,value.getX()),value.getY()),value.getZ());}
+	static size_t fingerprint(size_t seed,const Switch& value) {return fingerprint(seed,value.getState());}
+
+	template <typename P,typename O> static size_t fingerprint(size_t seed,const DataTemplate<P,O>& value)
+	{
+		seed = fingerprint(seed,value.getPosition());
+		seed = fingerprint(seed,value.getOrientation());
+		seed = fingerprint(seed,value.getConfidence());
+		return fingerprint(seed,value.getIntensity());
+	}
+
+	// Bring back in the stored Groups the Groups added, replaced or removed by a Processor in its selection
+	template <typename H> static void mergeModifiedGroups(map<string,GroupTemplate<H>*>& groups,const map<string,GroupTemplate<H>*>& given,map<string,GroupTemplate<H>*>& selected)
+	{
+		for(typename map<string,GroupTemplate<H>*>::const_iterator git = given.begin();git != given.end();git++)
+		{
+			typename map<string,GroupTemplate<H>*>::iterator sit = selected.find(git->first);
+			if(sit == selected.end()) groups.erase(git->first);
+			else if(sit->second != git->second) groups[git->first] = sit->second;
+		}
+
+		for(typename map<string,GroupTemplate<H>*>::iterator sit = selected.begin();sit != selected.end();sit++)
+		{
+			if(given.count(sit->first)) continue;
+
+			typename map<string,GroupTemplate<H>*>::iterator git = groups.find(sit->first);
+			if(git == groups.end())
+			{
+				groups[sit->first] = sit->second;
+				continue;
+			}
+
+			// The Processor created a Group which already exists but was not given to it : copy its HistoricTemplate in the stored one
+			const map<string,H*>& elements = sit->second->getAll();
+			for(typename map<string,H*>::const_iterator eit = elements.begin();eit != elements.end();eit++)
+			{
+				git->second->removeElementByID(eit->first);
+				git->second->addElement(eit->first,new H(*eit->second));
+			}
+			delete sit->second;
+		}
+	}
+
+	// Delete a Node through its kind (the destructor of Node is not virtual)
+	static void deleteNode(Node* node)
+	{
+		if(dynamic_cast<Generator*>(node) != 0) delete dynamic_cast<Generator*>(node);
+		else if(dynamic_cast<Processor*>(node) != 0) delete dynamic_cast<Processor*>(node);
+		else if(dynamic_cast<Observer*>(node) != 0) delete dynamic_cast<Observer*>(node);
+	}
+
+	// Nodes started (or stopped) concurrently, each thread taking the next one
+	struct NodeTasks
+	{
+		const vector<Node*>* nodes;
+		vector<char>* results;
+		atomic<size_t>* next;
+		bool starting;
+		int tries;
+	};
+
+	// Start (or stop) a Node, retrying if needed
+	static bool retry(Node* node,bool starting,int tries)
+	{
+		for(int t = 0;t < tries;t++)
+			if(starting ? node->start() : node->stop()) return true;
+		return false;
+	}
+
+	static void runNodeTasks(NodeTasks* tasks)
+	{
+		size_t i;
+		while((i = (*tasks->next)++) < tasks->nodes->size())
+			(*tasks->results)[i] = retry((*tasks->nodes)[i],tasks->starting,tasks->tries) ? 1 : 0;
+	}
+
+	// Get the Group of an id from the selected Groups
+	template <typename G> static void takeGroup(const map<string,G*>& selected,const string& groupID,map<string,G*>& given)
+	{
+		typename map<string,G*>::const_iterator git = selected.find(groupID);
+		if(git != selected.end()) given.insert(*git);
+	}
+
+	// Add the ids of the Groups to a set
+	template <typename G> static void addGroupIDs(const map<string,G*>& groups,set<string>& ids)
+	{
+		for(typename map<string,G*>::const_iterator git = groups.begin();git != groups.end();git++) ids.insert(git->first);
+	}
+
+	// Remove the Groups that a Processor or an Observer does not process (by their ids and types)
+	template <typename G> static void removeIgnoredGroups(map<string,G*>& groups,const Node* node)
+	{
+		const Processor* processor = dynamic_cast<const Processor*>(node);
+		const Observer* observer = dynamic_cast<const Observer*>(node);
+		for(typename map<string,G*>::iterator git = groups.begin();git != groups.end();)
+		{
+			string type = git->second->getType();
+			bool processed = (processor != 0) ? processor->isProcessedGroup(git->first,type) : ((observer == 0)||(observer->isObservedGroup(git->first,type)));
+			if(processed) git++;
+			else groups.erase(git++);
+		}
+	}
+
+	// Update of the clone of a sharded Node with the Groups of its id
+	struct ShardUpdate
+	{
+		Node* shard;
+		map<string,GroupSwitch*> givenSwitch;
+		map<string,Group1D*> given1D;
+		map<string,Group2D*> given2D;
+		map<string,Group3D*> given3D;
+		map<string,GroupSwitch*> updatedSwitch;
+		map<string,Group1D*> updated1D;
+		map<string,Group2D*> updated2D;
+		map<string,Group3D*> updated3D;
+		bool success;
+	};
+
+	// Clones of a sharded Node updated by a ThreadPool
+	struct ShardTasks
+	{
+		vector<ShardUpdate>* updates;
+		int tries;
+	};
+
+	// Update a clone, retrying if needed (only touches the ShardUpdate of the task)
+	static void runShardTask(size_t index,void* context)
+	{
+		ShardTasks* tasks = static_cast<ShardTasks*>(context);
+		ShardUpdate& update = (*tasks->updates)[index];
+		update.success = false;
+		for(int t = 0;(t < tasks->tries)&&(!update.success);t++)
+			update.success = update.shard->update(update.updated3D,update.updated2D,update.updated1D,update.updatedSwitch);
+	}
+
+	template <typename G> static void deleteGroups(map<string,G*>& groups)
+	{
+		for(typename map<string,G*>::iterator git = groups.begin();git != groups.end();git++) delete git->second;
+		groups.clear();
+	}
+
+	void Scheduler::forgetGroup(const map<string,Group3D*>& /*groups*/,const string& groupID)
+	{
+		for(vector<ScheduledNode>::iterator it = _schedule.begin();it != _schedule.end();it++)
+		{
+			FilterProcessor* filter = it->processor ? dynamic_cast<FilterProcessor*>(it->node) : 0;
+			if(filter != 0) filter->removeGroupState(groupID);
+		}
+	}
+
+	template <typename G> void Scheduler::removeGroupSlot(const map<string,G*>& groups,GroupSlots<G>& slots,const GroupHandle& handle)
+	{
+		const string* groupID = slots.slots.idOf(handle);
+		if(groupID == 0) return;
+
+		forgetGroup(groups,*groupID);
+		const map<string,ElementState>& removed = slots.slots.get(handle)->state.elements;
+		for(map<string,ElementState>::const_iterator esit = removed.begin();esit != removed.end();esit++) countType(esit->second.bit,-1);
+		slots.slots.erase(handle);
+	}
+
+	// Record the modifications of the HistoricTemplate of the given types (all types if empty), stamping them with the given epoch
+	// The modified HistoricTemplate are trimmed to the window or the length declared for their type or their Group
+	template <typename H> void Scheduler::refreshGroupStates(map<string,GroupTemplate<H>*>& groups,GroupSlots<GroupTemplate<H> >& slots,const set<string>& types,unsigned long epoch)
+	{
+		bool declaredLengths = ((!_historicLengths.empty())||(!_groupHistoricLengths.empty())||(!_historicWindows.empty()));
+		_sortedHandles.clear();
+		size_t k = 0;
+		for(typename map<string,GroupTemplate<H>*>::iterator git = groups.begin();git != groups.end();git++)
+		{
+			// Walk the map and the previous order together : the slots passed over belong to removed Groups, a missing slot is a new Group
+			int comparison = 1;
+			while(k < slots.sorted.size())
+			{
+				comparison = slots.slots.idOf(slots.sorted[k])->compare(git->first);
+				if(comparison >= 0) break;
+				removeGroupSlot(groups,slots,slots.sorted[k++]);
+			}
+			GroupHandle handle;
+			if((k < slots.sorted.size())&&(comparison == 0)) handle = slots.sorted[k++];
+			else handle = slots.slots.insert(git->first,GroupSlot<GroupTemplate<H> >());
+			_sortedHandles.push_back(handle);
+
+			GroupSlot<GroupTemplate<H> >& slot = *slots.slots.get(handle);
+			slot.group = git->second;
+			GroupState& state = slot.state;
+			const map<string,H*>& elements = git->second->getAll();
+
+			for(typename map<string,H*>::const_iterator eit = elements.begin();eit != elements.end();eit++)
+			{
+				string type = eit->second->getType();
+				if((!types.empty())&&(types.count(type) == 0)) continue;
+
+				int lastTimestamp = eit->second->getLastTimestamp();
+				size_t size = eit->second->getHistoric().size();
+				size_t last = eit->second->isEmpty() ? 0 : fingerprint(0,*eit->second->getLast());
+
+				map<string,ElementState>::iterator esit = state.elements.find(eit->first);
+				if((esit != state.elements.end())&&(esit->second.lastTimestamp == lastTimestamp)&&(esit->second.size == size)&&(esit->second.fingerprint == last)) continue;
+
+				// Same last timestamp and same number of values : the last value has been rewritten in place
+				bool rewritten = ((esit != state.elements.end())&&(esit->second.lastTimestamp == lastTimestamp)&&(esit->second.size == size));
+				unsigned long version = rewritten ? esit->second.version + 1 : 0;
+
+				if(!_statisticsTypes.empty())
+				{
+					map<string,HistoricStatistics>::iterator stit = _statisticsTypes.find(type);
+					if(stit != _statisticsTypes.end())
+					{
+						map<string,HistoricStatistics>::iterator hsit = state.statistics.find(eit->first);
+						if(hsit == state.statistics.end()) hsit = state.statistics.insert(make_pair(eit->first,stit->second)).first;
+						hsit->second.update(eit->second->getHistoric());
+					}
+				}
+
+				if(declaredLengths)
+				{
+					trimHistoric(git->first,eit->second);
+					size = eit->second->getHistoric().size();
+				}
+
+				if(esit == state.elements.end())
+				{
+					esit = state.elements.insert(make_pair(eit->first,ElementState())).first;
+					esit->second.bit = getTypeBit(type);
+					countType(esit->second.bit,1);
+				}
+				ElementState& element = esit->second;
+				element.type = type;
+				element.lastTimestamp = lastTimestamp;
+				element.size = size;
+				element.fingerprint = last;
+				element.version = version;
+				state.types[type] = epoch;
+				state.timestamps[type] = lastTimestamp;
+				state.epoch = epoch;
+			}
+
+			// Removed HistoricTemplate are a modification of their type
+			map<string,ElementState>::iterator esit = state.elements.begin();
+			while(esit != state.elements.end())
+			{
+				if(((!types.empty())&&(types.count(esit->second.type) == 0))||(elements.count(esit->first)))
+				{
+					esit++;
+					continue;
+				}
+				state.types[esit->second.type] = epoch;
+				state.epoch = epoch;
+				state.statistics.erase(esit->first);
+				countType(esit->second.bit,-1);
+				state.elements.erase(esit++);
+			}
+		}
+		while(k < slots.sorted.size()) removeGroupSlot(groups,slots,slots.sorted[k++]);
+		slots.sorted.swap(_sortedHandles);
+	}
+
+	// Keep the Groups in which one of the given types has been modified after the given epoch
+	template <typename H> void Scheduler::selectGroups(map<string,GroupTemplate<H>*>& groups,GroupSlots<GroupTemplate<H> >& slots,const ScheduledNode& scheduled,map<string,GroupTemplate<H>*>& selected)
+	{
+		// The sorted handles follow the map unless a Node changed the Groups since the last refresh (then the ids are looked up)
+		bool sorted = (slots.sorted.size() == groups.size());
+		size_t k = 0;
+		for(typename map<string,GroupTemplate<H>*>::iterator git = groups.begin();git != groups.end();git++,k++)
+		{
+			GroupSlot<GroupTemplate<H> >* slot = sorted ? slots.slots.get(slots.sorted[k]) : 0;
+			if((slot != 0)&&((slot->group != git->second)||(*slots.slots.idOf(slots.sorted[k]) != git->first))) slot = 0;
+			if(slot == 0) slot = slots.slots.get(git->first);
+			GroupState* state = (slot == 0) ? 0 : &slot->state;
+
+			if(_dirtyTracking)
+			{
+				bool modified = false;
+				if((state != 0)&&(state->epoch > scheduled.lastRun))
+				{
+					for(set<string>::const_iterator tit = scheduled.inputs.begin();(tit != scheduled.inputs.end())&&(!modified);tit++)
+					{
+						map<string,unsigned long>::iterator eit = state->types.find(*tit);
+						modified = ((eit != state->types.end())&&(eit->second > scheduled.lastRun));
+					}
+				}
+				if(!modified) continue;
+			}
+
+			// Mask the Groups in which a needed type is older than its budget
+			bool stale = false;
+			if(state != 0)
+			{
+				for(map<string,int>::const_iterator bit = scheduled.budgets.begin();(bit != scheduled.budgets.end())&&(!stale);bit++)
+				{
+					map<string,int>::iterator tit = state->timestamps.find(bit->first);
+					stale = ((tit != state->timestamps.end())&&(_timestamp - tit->second > bit->second));
+				}
+			}
+			if(stale)
+			{
+				_metrics.staleDrops++;
+				continue;
+			}
+
+			selected.insert(selected.end(),*git);
+		}
+	}
+
+	template <typename H> void Scheduler::trimHistoric(const string& groupID,H* historic)
+	{
+		map<string, int>::const_iterator wit = _historicWindows.find(historic->getType());
+		if(wit == _historicWindows.end())
+		{
+			historic->trimHistoric(getHistoricLength(groupID,historic->getType()));
+			return;
+		}
+
+		// Retained by time : a declared length is still honoured, otherwise only the last value is kept beyond the window
+		int length = getDeclaredHistoricLength(groupID,historic->getType());
+		historic->trimHistoricBefore(_timestamp - wit->second,(length > 0) ? length : 1);
+
+		// The Environment drops the oldest value beyond its length : it must stay above the number of values of the window,
+		// which depends on the rate of the Generator, so it is doubled before the window fills it
+		int size = (int)historic->getHistoric().size();
+		int environmentLength = _environment->getHistoricLength();
+		if((size*2 <= environmentLength)||(historic->getLastTimestamp() - historic->getTimeSpan() < _timestamp - wit->second)) return;
+		if(size >= environmentLength) _metrics.truncatedWindows++;
+		while(_windowHistoricLength < size*2) _windowHistoricLength *= 2;
+		if(_windowHistoricLength > environmentLength) _environment->setHistoricLength(_windowHistoricLength);
+	}
+
+	Scheduler::Scheduler(Environment* environment) : _environment(environment),_priorities(environment->getPriorities()),_nameCounter(0),_scheduleChanged(true),_running(false),_epoch(0),_dirtyTracking(false),_fusion(true),_inputSkipping(false),_defaultHistoricLength(environment->getHistoricLength()),_windowHistoricLength(LG_HISTORIC_WINDOW_LENGTH),_timer("ms"),_timestamp(0),_started(false),_parallelStart(false),_shardPool(0)
+	{
+		lock_guard<mutex> lock(schedulersMutex);
+		schedulers[environment] = this;
+	}
+
+	Scheduler::~Scheduler(void)
+	{
+		{
+			lock_guard<mutex> lock(schedulersMutex);
+			map<Environment*, Scheduler*>::iterator sit = schedulers.find(_environment);
+			if((sit != schedulers.end())&&(sit->second == this)) schedulers.erase(sit);
+		}
+
+		while(!_shards.empty()) removeShards(_shards.begin()->first,true);
+		delete _shardPool;
+
+		// The Environment must not keep the Nodes created from the NodeFactory
+		bool runtimeChanges = _environment->runtimeChangesEnabled();
+		_environment->enableRuntimeChanges(true);
+		for(vector<Node*>::iterator it = _createdNodes.begin();it != _createdNodes.end();it++)
+		{
+			_environment->unregisterNode(*it);
+			deleteNode(*it);
+		}
+		_environment->enableRuntimeChanges(runtimeChanges);
+
+		deleteGroups(_groupsSwitch);
+		deleteGroups(_groups1D);
+		deleteGroups(_groups2D);
+		deleteGroups(_groups3D);
+	}
+
+	bool Scheduler::addNode(string uniqueName,Node* node,int priority)
+	{
+		// Nodes may also have been registered directly in the Environment
+		_priorities = _environment->getPriorities();
+		map<string, Node*> nodes = _environment->getNodes();
+
+		char buffer[128];
+		if(priority == INT_MIN) priority = getFreePriority();
+		else if(_priorities.count(priority))
+		{
+			snprintf(buffer,sizeof(buffer),"libGina : Cannot register node : priority %d already in use.",priority);
+			_error = buffer;
+			return false;
+		}
+
+		if(uniqueName.empty())
+		{
+			// Same unique names as the Environment, skipping the ones already given
+			do
+			{
+				snprintf(buffer,sizeof(buffer),"-%d",_nameCounter);
+				_nameCounter += 1000;
+				uniqueName = node->getName() + buffer;
+			}
+			while(nodes.count(uniqueName));
+		}
+		else if(nodes.count(uniqueName))
+		{
+			_error = "libGina : Cannot register node : node name " + uniqueName + " already in use.";
+			return false;
+		}
+
+		if(!_environment->registerNode(uniqueName,node,priority))
+		{
+			_error = _environment->getLastError();
+			return false;
+		}
+
+		addToGraph(uniqueName,node,priority);
+		return true;
+	}
+
+	int Scheduler::getFreePriority() const
+	{
+		int priority = 0;
+		for(map<int, string>::const_iterator pit = _priorities.lower_bound(0);(pit != _priorities.end())&&(pit->first == priority);pit++) priority++;
+		return priority;
+	}
+
+	void Scheduler::addToGraph(const string& uniqueName,Node* node,int priority)
+	{
+		_names[node] = uniqueName;
+		_priorities[priority] = uniqueName;
+		_graph.addNode(uniqueName,node,priority);
+		if((_scheduleChanged)||(_running)) _scheduleChanged = true;
+		else insertScheduledNode(uniqueName,node,priority);
+
+		HistoricRequirement* requirement = dynamic_cast<HistoricRequirement*>(node);
+		if(requirement == 0) return;
+		_declaredLengths[uniqueName] = requirement->historicLengths();
+		_declaredGroupLengths[uniqueName] = requirement->groupHistoricLengths();
+		_declaredWindows[uniqueName] = requirement->historicWindows();
+		updateHistoricLengths();
+	}
+
+	void Scheduler::updateHistoricLengths()
+	{
+		_historicLengths = _lengthPolicies;
+		_groupHistoricLengths.clear();
+		_historicWindows = _windowPolicies;
+		int longest = _defaultHistoricLength;
+		for(map<string, int>::iterator lit = _lengthPolicies.begin();lit != _lengthPolicies.end();lit++)
+			if(lit->second > longest) longest = lit->second;
+
+		map<string, map<string, int> >* declared[2] = {&_declaredLengths,&_declaredGroupLengths};
+		map<string, int>* lengths[2] = {&_historicLengths,&_groupHistoricLengths};
+		for(int i = 0;i < 2;i++)
+		{
+			for(map<string, map<string, int> >::iterator nit = declared[i]->begin();nit != declared[i]->end();nit++)
+			{
+				for(map<string, int>::iterator lit = nit->second.begin();lit != nit->second.end();lit++)
+				{
+					int& length = (*lengths[i])[lit->first];
+					if(lit->second > length) length = lit->second;
+					if(length > longest) longest = length;
+				}
+			}
+		}
+
+		for(map<string, map<string, int> >::iterator nit = _declaredWindows.begin();nit != _declaredWindows.end();nit++)
+		{
+			for(map<string, int>::iterator wit = nit->second.begin();wit != nit->second.end();wit++)
+			{
+				map<string, int>::iterator hit = _historicWindows.find(wit->first);
+				if(hit == _historicWindows.end()) _historicWindows[wit->first] = wit->second;
+				else if(wit->second > hit->second) hit->second = wit->second;
+			}
+		}
+
+		// The Environment trims every HistoricTemplate to its own length : it must not be shorter than any declared length,
+		// and cannot trim by time (the number of values in a window depends on the rate of the Generators, see trimHistoric), but still bounds the other types
+		if((!_historicWindows.empty())&&(longest < _windowHistoricLength)) longest = _windowHistoricLength;
+		_environment->setHistoricLength(longest);
+	}
+
+	int Scheduler::getDeclaredHistoricLength(const string& groupID,const string& type) const
+	{
+		map<string, int>::const_iterator tit = _historicLengths.find(type);
+		map<string, int>::const_iterator git = _groupHistoricLengths.find(groupID);
+		if((tit == _historicLengths.end())&&(git == _groupHistoricLengths.end())) return -1;
+
+		int length = 0;
+		if((tit != _historicLengths.end())&&(tit->second > length)) length = tit->second;
+		if((git != _groupHistoricLengths.end())&&(git->second > length)) length = git->second;
+		return length;
+	}
+
+	int Scheduler::getHistoricLength(const string& groupID,const string& type) const
+	{
+		int length = getDeclaredHistoricLength(groupID,type);
+		return (length < 0) ? _defaultHistoricLength : length;
+	}
+
+	void Scheduler::setHistoricLength(string type,int length)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		if(length < 0) _lengthPolicies.erase(type);
+		else _lengthPolicies[type] = length;
+		updateHistoricLengths();
+	}
+
+	void Scheduler::setHistoricWindow(string type,int window)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		if(window < 0) _windowPolicies.erase(type);
+		else _windowPolicies[type] = window;
+		updateHistoricLengths();
+	}
+
+	int Scheduler::getHistoricWindow(string type) const
+	{
+		map<string, int>::const_iterator wit = _historicWindows.find(type);
+		if(wit == _historicWindows.end()) return -1;
+		return wit->second;
+	}
+
+	void Scheduler::setDefaultHistoricLength(int length)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		_defaultHistoricLength = length;
+		updateHistoricLengths();
+	}
+
+	bool Scheduler::registerNode(Node* node)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		return addNode(string(),node,INT_MIN);
+	}
+
+	bool Scheduler::registerNode(Node* node,int priority)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		return addNode(string(),node,priority);
+	}
+
+	bool Scheduler::registerNode(string uniqueName,Node* node)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		return addNode(uniqueName,node,INT_MIN);
+	}
+
+	bool Scheduler::registerNode(string uniqueName,Node* node,int priority)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		return addNode(uniqueName,node,priority);
+	}
+
+	bool Scheduler::unregisterNode(Node* node)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		map<Node*, string>::iterator nit = _names.find(node);
+		if(nit == _names.end())
+		{
+			_error = "libGina : Error : node not registered through this scheduler.";
+			return false;
+		}
+		return unregisterNode(nit->second);
+	}
+
+	bool Scheduler::unregisterNode(string uniqueName)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		if(!_environment->unregisterNode(uniqueName))
+		{
+			_error = _environment->getLastError();
+			return false;
+		}
+
+		_graph.removeNode(uniqueName);
+		int priority = -1;
+		for(map<int, string>::iterator pit = _priorities.begin();pit != _priorities.end();pit++)
+		{
+			if(pit->second != uniqueName) continue;
+			priority = pit->first;
+			_priorities.erase(pit);
+			break;
+		}
+		if((_scheduleChanged)||(_running)) _scheduleChanged = true;
+		else removeScheduledNode(uniqueName,priority);
+		if(_declaredLengths.erase(uniqueName) + _declaredGroupLengths.erase(uniqueName) + _declaredWindows.erase(uniqueName) > 0) updateHistoricLengths();
+		_declaredChannels.erase(uniqueName);
+		_shardedNodes.erase(uniqueName);
+		removeShards(uniqueName,true);
+		for(map<Node*, string>::iterator nit = _names.begin();nit != _names.end();nit++)
+		{
+			if(nit->second != uniqueName) continue;
+			_startedNodes.erase(remove(_startedNodes.begin(),_startedNodes.end(),nit->first),_startedNodes.end());
+			_names.erase(nit);
+			break;
+		}
+		return true;
+	}
+
+	string Scheduler::getUniqueName(Node* node) const
+	{
+		map<Node*, string>::const_iterator nit = _names.find(node);
+		if(nit == _names.end()) return string();
+		return nit->second;
+	}
+
+	size_t Scheduler::getTypeBit(const string& type)
+	{
+		map<string, size_t>::iterator bit = _typeBits.find(type);
+		if(bit != _typeBits.end()) return bit->second;
+
+		size_t index = _typeBits.size();
+		_typeBits[type] = index;
+		_typeCounts.push_back(0);
+		if(index/(8*sizeof(unsigned long)) >= _presence.size()) _presence.push_back(0);
+		return index;
+	}
+
+	void Scheduler::countType(size_t bit,int count)
+	{
+		unsigned int& number = _typeCounts[bit];
+		if((count < 0)&&(number == 0)) return;
+		number += count;
+
+		unsigned long mask = 1UL << (bit % (8*sizeof(unsigned long)));
+		if(number == 0) _presence[bit/(8*sizeof(unsigned long))] &= ~mask;
+		else _presence[bit/(8*sizeof(unsigned long))] |= mask;
+	}
+
+	bool Scheduler::hasInputs(const ScheduledNode& scheduled) const
+	{
+		for(size_t i = 0;i < scheduled.inputBits.size();i++)
+			if(_presence[i] & scheduled.inputBits[i]) return true;
+		return false;
+	}
+
+	bool Scheduler::isTypePresent(string type) const
+	{
+		map<string, size_t>::const_iterator bit = _typeBits.find(type);
+		if(bit == _typeBits.end()) return false;
+		return (_typeCounts[bit->second] > 0);
+	}
+
+	void Scheduler::describeNode(const string& uniqueName,Node* node,int priority,ScheduledNode& scheduled)
+	{
+		scheduled.name = uniqueName;
+		scheduled.priority = priority;
+		scheduled.node = node;
+		scheduled.generator = (node->getType() == LG_NODE_GENERATOR);
+		scheduled.processor = (node->getType() == LG_NODE_PROCESSOR);
+		scheduled.inputs = node->need();
+		set<string> consume = node->consume();
+		scheduled.inputs.insert(consume.begin(),consume.end());
+		scheduled.outputs = node->produce();
+		scheduled.outputs.insert(consume.begin(),consume.end());
+		scheduled.lastRun = 0;
+		scheduled.fused = false;
+		scheduled.sharded = (_shardedNodes.count(uniqueName) > 0);
+		map<string, int>::iterator cit = _declaredChannels.find(uniqueName);
+		if(cit != _declaredChannels.end()) scheduled.channels = cit->second;
+		else
+		{
+			set<string> types = scheduled.inputs;
+			types.insert(scheduled.outputs.begin(),scheduled.outputs.end());
+			scheduled.channels = getChannelsOfTypes(types);
+		}
+		for(set<string>::iterator it = scheduled.inputs.begin();it != scheduled.inputs.end();it++)
+		{
+			size_t bit = getTypeBit(*it);
+			scheduled.inputBits.resize(_presence.size(),0);
+			scheduled.inputBits[bit/(8*sizeof(unsigned long))] |= 1UL << (bit % (8*sizeof(unsigned long)));
+		}
+		for(set<string>::iterator it = scheduled.inputs.begin();it != scheduled.inputs.end();it++)
+		{
+			map<string, int>::iterator bit = _freshnessBudgets.find(*it);
+			if(bit != _freshnessBudgets.end()) scheduled.budgets[*it] = bit->second;
+		}
+	}
+
+	void Scheduler::buildSchedule()
+	{
+		// Keep the last update epoch of the Nodes already scheduled
+		map<string, unsigned long> lastRuns;
+		for(vector<ScheduledNode>::iterator it = _schedule.begin();it != _schedule.end();it++)
+			lastRuns[it->name] = it->lastRun;
+
+		// Nodes may also have been registered directly in the Environment
+		_schedule.clear();
+		_priorities = _environment->getPriorities();
+		map<string, Node*> nodes = _environment->getNodes();
+		for(map<int, string>::iterator pit = _priorities.begin();pit != _priorities.end();pit++)
+		{
+			map<string, Node*>::iterator nit = nodes.find(pit->second);
+			if(nit == nodes.end()) continue;
+
+			_schedule.push_back(ScheduledNode());
+			describeNode(nit->first,nit->second,pit->first,_schedule.back());
+			if(lastRuns.count(nit->first)) _schedule.back().lastRun = lastRuns[nit->first];
+		}
+
+		updateChains(0,_schedule.size(),0);
+		_subSchedules.clear();
+		_scheduleChanged = false;
+	}
+
+	void Scheduler::insertScheduledNode(const string& uniqueName,Node* node,int priority)
+	{
+		ScheduledNode scheduled;
+		describeNode(uniqueName,node,priority,scheduled);
+		size_t position = 0;
+		while((position < _schedule.size())&&(_schedule[position].priority < priority)) position++;
+		_schedule.insert(_schedule.begin() + position,scheduled);
+
+		// Only the chain around the new Node may change, the indices after it are shifted
+		updateChains(position,position + 2,1);
+
+		// Sub-schedules reaching the new Node are computed again, the others are shifted
+		for(map<string, vector<size_t> >::iterator sit = _subSchedules.begin();sit != _subSchedules.end();)
+		{
+			bool reached = false;
+			for(vector<size_t>::iterator it = sit->second.begin();it != sit->second.end();it++)
+			{
+				if(*it >= position) (*it)++;
+				if(_graph.getSuccessors(_schedule[*it].name).count(uniqueName)) reached = true;
+			}
+			if(reached) _subSchedules.erase(sit++);
+			else sit++;
+		}
+	}
+
+	void Scheduler::removeScheduledNode(const string& uniqueName,int priority)
+	{
+		size_t position = 0;
+		while((position < _schedule.size())&&(_schedule[position].priority < priority)) position++;
+		if((position == _schedule.size())||(_schedule[position].name != uniqueName))
+		{
+			_scheduleChanged = true;
+			return;
+		}
+		_schedule.erase(_schedule.begin() + position);
+		updateChains(position,position + 1,-1);
+
+		// Sub-schedules going through the removed Node are computed again, the others are shifted
+		_subSchedules.erase(uniqueName);
+		for(map<string, vector<size_t> >::iterator sit = _subSchedules.begin();sit != _subSchedules.end();)
+		{
+			vector<size_t>& positions = sit->second;
+			if(find(positions.begin(),positions.end(),position) != positions.end())
+			{
+				_subSchedules.erase(sit++);
+				continue;
+			}
+			for(vector<size_t>::iterator it = positions.begin();it != positions.end();it++)
+				if(*it > position) (*it)--;
+			sit++;
+		}
+	}
+
+	void Scheduler::updateChains(size_t position,size_t stable,int shift)
+	{
+		// Chains of consecutive in place filters on the same types, from the head of the chain before the position
+		size_t first = (position > 0) ? position - 1 : 0;
+		while((first > 0)&&(first < _schedule.size())&&(_schedule[first].fused)) first--;
+
+		size_t head = first;
+		FilterProcessor* previous = 0;
+		size_t i = first;
+		for(;i < _schedule.size();i++)
+		{
+			ScheduledNode& scheduled = _schedule[i];
+			FilterProcessor* filter = ((_fusion)&&(scheduled.processor)&&(!scheduled.sharded)) ? dynamic_cast<FilterProcessor*>(scheduled.node) : 0;
+			bool fused = (filter != 0)&&(previous != 0)&&(previous->canFuseWith(filter));
+
+			// After the changed Nodes, the chains starting from a Node not fused are unchanged
+			if((i >= stable)&&(!fused)) break;
+
+			scheduled.chain.clear();
+			scheduled.followers.clear();
+			scheduled.fused = fused;
+			if(fused)
+			{
+				if(_schedule[head].chain.empty()) _schedule[head].chain.push_back(previous);
+				_schedule[head].chain.push_back(filter);
+				_schedule[head].followers.push_back(i);
+			}
+			else head = i;
+			previous = filter;
+		}
+
+		if(shift == 0) return;
+		for(;i < _schedule.size();i++)
+			for(vector<size_t>::iterator it = _schedule[i].followers.begin();it != _schedule[i].followers.end();it++)
+				*it += shift;
+	}
+
+	const vector<size_t>& Scheduler::getSubSchedule(const string& generatorName)
+	{
+		map<string, vector<size_t> >::iterator sit = _subSchedules.find(generatorName);
+		if(sit != _subSchedules.end()) return sit->second;
+
+		// Nodes reachable from the Generator through the produced/needed types
+		set<string> reachable;
+		vector<string> toVisit(1,generatorName);
+		while(!toVisit.empty())
+		{
+			string current = toVisit.back();
+			toVisit.pop_back();
+			if(!reachable.insert(current).second) continue;
+
+			set<string> successors = _graph.getSuccessors(current);
+			toVisit.insert(toVisit.end(),successors.begin(),successors.end());
+		}
+
+		vector<size_t>& positions = _subSchedules[generatorName];
+		for(size_t i = 0;i < _schedule.size();i++)
+			if(reachable.count(_schedule[i].name)) positions.push_back(i);
+		return positions;
+	}
+
+	bool Scheduler::runSchedule(const vector<size_t>* positions)
+	{
+		_timestamp = _timer.getTimeFromStart();
+		_metrics.updates++;
+
+		// Nodes registered by the updated Nodes must not move the schedule being run
+		string failed;
+		_running = true;
+		if(positions == 0)
+		{
+			for(vector<ScheduledNode>::iterator it = _schedule.begin();it != _schedule.end();it++)
+				if(!updateNode(*it)) failed += " " + it->name;
+		}
+		else
+		{
+			for(vector<size_t>::const_iterator it = positions->begin();it != positions->end();it++)
+				if(!updateNode(_schedule[*it])) failed += " " + _schedule[*it].name;
+		}
+		_running = false;
+
+		if(!failed.empty())
+		{
+			_error = "Cannot update : some nodes didn't update :" + failed;
+			return false;
+		}
+		return _lazyNodes.empty() || instantiateLazyNodes();
+	}
+
+	vector<vector<Node*> > Scheduler::getStartLevels() const
+	{
+		// Number of producers of each Node not placed in a level yet
+		map<string, Node*> nodes;
+		map<string, int> producers;
+		for(map<Node*, string>::const_iterator nit = _names.begin();nit != _names.end();nit++)
+		{
+			nodes[nit->second] = nit->first;
+			producers[nit->second];
+			set<string> successors = _graph.getSuccessors(nit->second);
+			for(set<string>::iterator sit = successors.begin();sit != successors.end();sit++)
+				if(*sit != nit->second) producers[*sit]++;
+		}
+
+		vector<string> current;
+		for(map<string, int>::iterator pit = producers.begin();pit != producers.end();pit++)
+			if(pit->second == 0) current.push_back(pit->first);
+
+		vector<vector<Node*> > levels;
+		while(!current.empty())
+		{
+			vector<Node*> level;
+			vector<string> next;
+			for(vector<string>::iterator cit = current.begin();cit != current.end();cit++)
+			{
+				level.push_back(nodes[*cit]);
+				producers.erase(*cit);
+				set<string> successors = _graph.getSuccessors(*cit);
+				for(set<string>::iterator sit = successors.begin();sit != successors.end();sit++)
+				{
+					map<string, int>::iterator pit = producers.find(*sit);
+					if((*sit != *cit)&&(pit != producers.end())&&(--pit->second == 0)) next.push_back(*sit);
+				}
+			}
+			levels.push_back(level);
+			current.swap(next);
+		}
+
+		// Nodes of a cycle
+		if(!producers.empty())
+		{
+			vector<Node*> level;
+			for(map<string, int>::iterator pit = producers.begin();pit != producers.end();pit++) level.push_back(nodes[pit->first]);
+			levels.push_back(level);
+		}
+		return levels;
+	}
+
+	void Scheduler::runConcurrently(const vector<Node*>& nodes,bool starting,string& failed)
+	{
+		vector<char> results(nodes.size(),0);
+		atomic<size_t> next(0);
+		NodeTasks tasks = {&nodes,&results,&next,starting,(_environment->getTryNumber() > 0) ? _environment->getTryNumber() : 1};
+
+		// Starting a Node mostly waits for its device or its files : one thread per Node (the calling thread takes part in the work)
+		vector<thread> workers;
+		for(size_t i = 1;i < nodes.size();i++) workers.push_back(thread(runNodeTasks,&tasks));
+		runNodeTasks(&tasks);
+		for(vector<thread>::iterator it = workers.begin();it != workers.end();it++) it->join();
+
+		for(size_t i = 0;i < nodes.size();i++)
+		{
+			if(!results[i]) failed += " " + getUniqueName(nodes[i]);
+			else if(starting) _startedNodes.push_back(nodes[i]);
+		}
+	}
+
+	bool Scheduler::registerLazyNode(string genericNodeName,set<string> inputs,int priority)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		if(!NodeFactory::isRegistered(genericNodeName))
+		{
+			_error = "libGina : Error : " + genericNodeName + " is not registered in the node factory.";
+			return false;
+		}
+
+		LazyNode lazy;
+		lazy.genericName = genericNodeName;
+		lazy.inputs = inputs;
+		lazy.priority = priority;
+		_lazyNodes.push_back(lazy);
+		return true;
+	}
+
+	Node* Scheduler::createNode(string genericNodeName,string uniqueName,int priority)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		Node* node = NodeFactory::create(genericNodeName);
+		if(node == 0)
+		{
+			_error = NodeFactory::getLastError();
+			return 0;
+		}
+
+		bool registered;
+		if(uniqueName.empty()) registered = (priority < 0) ? registerNode(node) : registerNode(node,priority);
+		else registered = (priority < 0) ? registerNode(uniqueName,node) : registerNode(uniqueName,node,priority);
+		if(!registered)
+		{
+			deleteNode(node);
+			return 0;
+		}
+		_createdNodes.push_back(node);
+		return node;
+	}
+
+	bool Scheduler::instantiateLazyNodes()
+	{
+		string failed;
+		for(size_t i = 0;i < _lazyNodes.size();)
+		{
+			bool present = false;
+			for(set<string>::iterator it = _lazyNodes[i].inputs.begin();(it != _lazyNodes[i].inputs.end())&&(!present);it++) present = isTypePresent(*it);
+			if(!present)
+			{
+				i++;
+				continue;
+			}
+
+			LazyNode lazy = _lazyNodes[i];
+			_lazyNodes.erase(_lazyNodes.begin() + i);
+
+			// A started Environment only accepts new Nodes with the runtime changes option
+			bool runtimeChanges = _environment->runtimeChangesEnabled();
+			_environment->enableRuntimeChanges(true);
+			// A running Environment starts the Node when registering it, the Scheduler only starts it with the parallel start option
+			Node* node = createNode(lazy.genericName,"",lazy.priority);
+			if((node != 0)&&(_parallelStart))
+			{
+				vector<Node*> started(1,node);
+				string notStarted;
+				runConcurrently(started,true,notStarted);
+				if(!notStarted.empty())
+				{
+					unregisterNode(node);
+					_createdNodes.pop_back();
+					deleteNode(node);
+					node = 0;
+				}
+			}
+			_environment->enableRuntimeChanges(runtimeChanges);
+			if(node == 0) failed += " " + lazy.genericName;
+		}
+
+		if(!failed.empty())
+		{
+			_error = "libGina : Error : cannot create lazy nodes :" + failed;
+			return false;
+		}
+		return true;
+	}
+
+	bool Scheduler::tryUpdate(Node* node,map<string,Group3D*>& groups3D,map<string,Group2D*>& groups2D,map<string,Group1D*>& groups1D,map<string,GroupSwitch*>& groupsSwitch)
+	{
+		int tries = (_environment->getTryNumber() > 0) ? _environment->getTryNumber() : 1;
+		for(int i = 0;i < tries;i++)
+			if(node->update(groups3D,groups2D,groups1D,groupsSwitch)) return true;
+		return false;
+	}
+
+	bool Scheduler::runNode(ScheduledNode& scheduled,map<string,Group3D*>& groups3D,map<string,Group2D*>& groups2D,map<string,Group1D*>& groups1D,map<string,GroupSwitch*>& groupsSwitch)
+	{
+		if(scheduled.chain.empty()) return tryUpdate(scheduled.node,groups3D,groups2D,groups1D,groupsSwitch);
+
+		for(vector<size_t>::iterator it = scheduled.followers.begin();it != scheduled.followers.end();it++)
+		{
+			_schedule[*it].node->updateTime(_timestamp);
+			_schedule[*it].lastRun = _epoch;
+		}
+		_metrics.fusedUpdates += scheduled.followers.size();
+		return FilterProcessor::updateChain(scheduled.chain,groups3D);
+	}
+
+	void Scheduler::refreshStates(const set<string>& types,int channels)
+	{
+		if(channels & LG_CHANNEL_SWITCH) refreshGroupStates(_groupsSwitch,_slotsSwitch,types,_epoch);
+		if(channels & LG_CHANNEL_1D) refreshGroupStates(_groups1D,_slots1D,types,_epoch);
+		if(channels & LG_CHANNEL_2D) refreshGroupStates(_groups2D,_slots2D,types,_epoch);
+		if(channels & LG_CHANNEL_3D) refreshGroupStates(_groups3D,_slots3D,types,_epoch);
+	}
+
+	bool Scheduler::reclaimEmptyChannels()
+	{
+		if(_emptySwitch.empty() && _empty1D.empty() && _empty2D.empty() && _empty3D.empty()) return false;
+
+		// Every Group of the empty maps is a Group added by the Node
+		mergeModifiedGroups(_groupsSwitch,map<string,GroupSwitch*>(),_emptySwitch);
+		mergeModifiedGroups(_groups1D,map<string,Group1D*>(),_empty1D);
+		mergeModifiedGroups(_groups2D,map<string,Group2D*>(),_empty2D);
+		mergeModifiedGroups(_groups3D,map<string,Group3D*>(),_empty3D);
+		_emptySwitch.clear();
+		_empty1D.clear();
+		_empty2D.clear();
+		_empty3D.clear();
+		return true;
+	}
+
+	bool Scheduler::updateNode(ScheduledNode& scheduled)
+	{
+		// Updated by the head of its chain
+		if(scheduled.fused) return true;
+
+		// None of its inputs is held by a Group
+		if((_inputSkipping)&&(!scheduled.generator)&&(!scheduled.inputs.empty())&&(!hasInputs(scheduled)))
+		{
+			_metrics.skippedNodes++;
+			return true;
+		}
+
+		if(scheduled.sharded) return updateShards(scheduled);
+
+		Node* node = scheduled.node;
+		node->updateTime(_timestamp);
+		int channels = scheduled.channels;
+
+		// Generators and Nodes without declared inputs, or nothing to select : all the Groups of their channels
+		if((scheduled.generator)||(scheduled.inputs.empty())||((!_dirtyTracking)&&(scheduled.budgets.empty())))
+		{
+			_epoch++;
+			_metrics.nodeUpdates++;
+			bool success = runNode(scheduled,(channels & LG_CHANNEL_3D) ? _groups3D : _empty3D,(channels & LG_CHANNEL_2D) ? _groups2D : _empty2D,
+				(channels & LG_CHANNEL_1D) ? _groups1D : _empty1D,(channels & LG_CHANNEL_SWITCH) ? _groupsSwitch : _emptySwitch);
+			scheduled.lastRun = _epoch;
+
+			// A Node writing in a channel it did not declare
+			if(reclaimEmptyChannels()) channels = LG_CHANNEL_ALL;
+			if((scheduled.generator)||(scheduled.processor)) refreshStates(scheduled.outputs,channels);
+			return success;
+		}
+
+		map<string,GroupSwitch*> selectedSwitch;
+		map<string,Group1D*> selected1D;
+		map<string,Group2D*> selected2D;
+		map<string,Group3D*> selected3D;
+		if(channels & LG_CHANNEL_SWITCH) selectGroups(_groupsSwitch,_slotsSwitch,scheduled,selectedSwitch);
+		if(channels & LG_CHANNEL_1D) selectGroups(_groups1D,_slots1D,scheduled,selected1D);
+		if(channels & LG_CHANNEL_2D) selectGroups(_groups2D,_slots2D,scheduled,selected2D);
+		if(channels & LG_CHANNEL_3D) selectGroups(_groups3D,_slots3D,scheduled,selected3D);
+
+		// Nothing changed since the last update of this Node (or only stale data)
+		if(selectedSwitch.empty() && selected1D.empty() && selected2D.empty() && selected3D.empty()) return true;
+
+		_epoch++;
+		_metrics.nodeUpdates++;
+		if(!scheduled.processor)
+		{
+			bool success = tryUpdate(node,selected3D,selected2D,selected1D,selectedSwitch);
+			scheduled.lastRun = _epoch;
+			return success;
+		}
+
+		map<string,GroupSwitch*> givenSwitch = selectedSwitch;
+		map<string,Group1D*> given1D = selected1D;
+		map<string,Group2D*> given2D = selected2D;
+		map<string,Group3D*> given3D = selected3D;
+
+		bool success = runNode(scheduled,selected3D,selected2D,selected1D,selectedSwitch);
+		scheduled.lastRun = _epoch;
+
+		mergeModifiedGroups(_groupsSwitch,givenSwitch,selectedSwitch);
+		mergeModifiedGroups(_groups1D,given1D,selected1D);
+		mergeModifiedGroups(_groups2D,given2D,selected2D);
+		mergeModifiedGroups(_groups3D,given3D,selected3D);
+		if((selectedSwitch.size() != givenSwitch.size())||(selected1D.size() != given1D.size())||(selected2D.size() != given2D.size())||(selected3D.size() != given3D.size())) channels = LG_CHANNEL_ALL;
+		refreshStates(scheduled.outputs,channels);
+		return success;
+	}
+
+	bool Scheduler::updateShards(ScheduledNode& scheduled)
+	{
+		// The clones of the removed Groups
+		removeShards(scheduled.name,false);
+
+		int channels = scheduled.channels;
+		map<string,GroupSwitch*> selectedSwitch;
+		map<string,Group1D*> selected1D;
+		map<string,Group2D*> selected2D;
+		map<string,Group3D*> selected3D;
+		if((scheduled.inputs.empty())||((!_dirtyTracking)&&(scheduled.budgets.empty())))
+		{
+			if(channels & LG_CHANNEL_SWITCH) selectedSwitch = _groupsSwitch;
+			if(channels & LG_CHANNEL_1D) selected1D = _groups1D;
+			if(channels & LG_CHANNEL_2D) selected2D = _groups2D;
+			if(channels & LG_CHANNEL_3D) selected3D = _groups3D;
+		}
+		else
+		{
+			if(channels & LG_CHANNEL_SWITCH) selectGroups(_groupsSwitch,_slotsSwitch,scheduled,selectedSwitch);
+			if(channels & LG_CHANNEL_1D) selectGroups(_groups1D,_slots1D,scheduled,selected1D);
+			if(channels & LG_CHANNEL_2D) selectGroups(_groups2D,_slots2D,scheduled,selected2D);
+			if(channels & LG_CHANNEL_3D) selectGroups(_groups3D,_slots3D,scheduled,selected3D);
+		}
+
+		// The Groups ignored by the Node do not get a clone
+		removeIgnoredGroups(selectedSwitch,scheduled.node);
+		removeIgnoredGroups(selected1D,scheduled.node);
+		removeIgnoredGroups(selected2D,scheduled.node);
+		removeIgnoredGroups(selected3D,scheduled.node);
+
+		set<string> ids;
+		addGroupIDs(selectedSwitch,ids);
+		addGroupIDs(selected1D,ids);
+		addGroupIDs(selected2D,ids);
+		addGroupIDs(selected3D,ids);
+		if(ids.empty()) return true;
+
+		_epoch++;
+		int tries = (_environment->getTryNumber() > 0) ? _environment->getTryNumber() : 1;
+		map<string, Node*>& shards = _shards[scheduled.name];
+		vector<ShardUpdate> updates;
+		string failed;
+		for(set<string>::iterator it = ids.begin();it != ids.end();it++)
+		{
+			// First Groups of this id : clone the Node
+			map<string, Node*>::iterator sit = shards.find(*it);
+			if(sit == shards.end())
+			{
+				Node* shard = scheduled.node->clone(scheduled.name + "_" + *it);
+				if((shard == 0)||(shard == scheduled.node))
+				{
+					failed += " " + scheduled.name + "(" + *it + ")";
+					continue;
+				}
+				shard->setEnvironment(_environment);
+				shard->setID(scheduled.node->getID());
+				if(!retry(shard,true,tries))
+				{
+					deleteNode(shard);
+					failed += " " + scheduled.name + "(" + *it + ")";
+					continue;
+				}
+				sit = shards.insert(make_pair(*it,shard)).first;
+			}
+
+			ShardUpdate update;
+			update.shard = sit->second;
+			takeGroup(selectedSwitch,*it,update.givenSwitch);
+			takeGroup(selected1D,*it,update.given1D);
+			takeGroup(selected2D,*it,update.given2D);
+			takeGroup(selected3D,*it,update.given3D);
+			update.updatedSwitch = update.givenSwitch;
+			update.updated1D = update.given1D;
+			update.updated2D = update.given2D;
+			update.updated3D = update.given3D;
+			update.success = false;
+			updates.push_back(update);
+
+			sit->second->updateTime(_timestamp);
+			_metrics.nodeUpdates++;
+		}
+
+		// The clones only touch the Groups of their ids : they can be updated concurrently, then merged back one after the other
+		ShardTasks tasks;
+		tasks.updates = &updates;
+		tasks.tries = tries;
+		if((_shardPool != 0)&&(updates.size() > 1)) _shardPool->run(updates.size(),runShardTask,&tasks);
+		else for(size_t i = 0;i < updates.size();i++) runShardTask(i,&tasks);
+
+		for(vector<ShardUpdate>::iterator uit = updates.begin();uit != updates.end();uit++)
+		{
+			if(!uit->success) failed += " " + uit->shard->getName();
+			if(!scheduled.processor) continue;
+
+			mergeModifiedGroups(_groupsSwitch,uit->givenSwitch,uit->updatedSwitch);
+			mergeModifiedGroups(_groups1D,uit->given1D,uit->updated1D);
+			mergeModifiedGroups(_groups2D,uit->given2D,uit->updated2D);
+			mergeModifiedGroups(_groups3D,uit->given3D,uit->updated3D);
+			if((uit->updatedSwitch.size() != uit->givenSwitch.size())||(uit->updated1D.size() != uit->given1D.size())||(uit->updated2D.size() != uit->given2D.size())||(uit->updated3D.size() != uit->given3D.size())) channels = LG_CHANNEL_ALL;
+		}
+		scheduled.lastRun = _epoch;
+		if(scheduled.processor) refreshStates(scheduled.outputs,channels);
+
+		if(!failed.empty())
+		{
+			_error = "libGina : Error : cannot update the clones :" + failed;
+			return false;
+		}
+		return true;
+	}
+
+	void Scheduler::removeShards(const string& uniqueName,bool all)
+	{
+		map<string, map<string, Node*> >::iterator nit = _shards.find(uniqueName);
+		if(nit == _shards.end()) return;
+
+		int tries = (_environment->getTryNumber() > 0) ? _environment->getTryNumber() : 1;
+		for(map<string, Node*>::iterator sit = nit->second.begin();sit != nit->second.end();)
+		{
+			if((!all)&&((_groupsSwitch.count(sit->first))||(_groups1D.count(sit->first))||(_groups2D.count(sit->first))||(_groups3D.count(sit->first))))
+			{
+				sit++;
+				continue;
+			}
+			retry(sit->second,false,tries);
+			deleteNode(sit->second);
+			nit->second.erase(sit++);
+		}
+		if(nit->second.empty()) _shards.erase(nit);
+	}
+
+	bool Scheduler::setSharded(Node* node,bool sharded)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		string uniqueName = getUniqueName(node);
+		if(uniqueName.empty())
+		{
+			_error = "libGina : Error : node not registered through this scheduler.";
+			return false;
+		}
+		if((sharded)&&(node->getType() != LG_NODE_PROCESSOR)&&(node->getType() != LG_NODE_OBSERVER))
+		{
+			_error = "libGina : Error : only processors and observers can be cloned per group.";
+			return false;
+		}
+
+		if(sharded) _shardedNodes.insert(uniqueName);
+		else
+		{
+			_shardedNodes.erase(uniqueName);
+			removeShards(uniqueName,true);
+		}
+		_scheduleChanged = true;
+		return true;
+	}
+
+	size_t Scheduler::getShardCount(Node* node) const
+	{
+		map<string, map<string, Node*> >::const_iterator nit = _shards.find(getUniqueName(node));
+		return (nit == _shards.end()) ? 0 : nit->second.size();
+	}
+
+	void Scheduler::setShardThreads(size_t threadNumber)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		if(threadNumber == 0) threadNumber = thread::hardware_concurrency();
+		delete _shardPool;
+		_shardPool = (threadNumber > 1) ? new ThreadPool(threadNumber) : 0;
+	}
+
+	bool Scheduler::start()
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		if(!_parallelStart)
+		{
+			if(!_environment->start())
+			{
+				_error = _environment->getLastError();
+				return false;
+			}
+		}
+		else
+		{
+			if(!checkCompatibility()) return false;
+
+			// A level only needs the Nodes of the previous levels to be started
+			vector<vector<Node*> > levels = getStartLevels();
+			for(vector<vector<Node*> >::iterator lit = levels.begin();lit != levels.end();lit++)
+			{
+				string failed;
+				runConcurrently(*lit,true,failed);
+				if(failed.empty()) continue;
+
+				string ignored;
+				runConcurrently(_startedNodes,false,ignored);
+				_startedNodes.clear();
+				_error = "libGina : Error : cannot start : some nodes didn't start :" + failed;
+				return false;
+			}
+		}
+		_timer.start();
+		_started = true;
+		return true;
+	}
+
+	bool Scheduler::stop()
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		_started = false;
+		while(!_shards.empty()) removeShards(_shards.begin()->first,true);
+
+		// In the reverse order of the levels : a Node is stopped before the Nodes feeding it
+		string failed;
+		if(!_startedNodes.empty())
+		{
+			set<Node*> started(_startedNodes.begin(),_startedNodes.end());
+			vector<vector<Node*> > levels = getStartLevels();
+			for(vector<vector<Node*> >::reverse_iterator lit = levels.rbegin();lit != levels.rend();lit++)
+			{
+				vector<Node*> level;
+				for(vector<Node*>::iterator nit = lit->begin();nit != lit->end();nit++)
+					if(started.count(*nit)) level.push_back(*nit);
+				runConcurrently(level,false,failed);
+			}
+			_startedNodes.clear();
+		}
+
+		if((!_parallelStart)&&(!_environment->stop()))
+		{
+			_error = _environment->getLastError();
+			return false;
+		}
+		if(!failed.empty())
+		{
+			_error = "libGina : Error : cannot stop : some nodes didn't stop :" + failed;
+			return false;
+		}
+		return true;
+	}
+
+	bool Scheduler::update()
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		if(!_started)
+		{
+			_error = "libGina : Cannot update : environment not started.";
+			return false;
+		}
+
+		if(_scheduleChanged) buildSchedule();
+		return runSchedule(0);
+	}
+
+	bool Scheduler::update(string generatorName)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		if(!_started)
+		{
+			_error = "libGina : Cannot update : environment not started.";
+			return false;
+		}
+
+		if(_scheduleChanged) buildSchedule();
+		const vector<size_t>& positions = _graph.hasNode(generatorName) ? getSubSchedule(generatorName) : vector<size_t>();
+		for(vector<size_t>::const_iterator it = positions.begin();it != positions.end();it++)
+			if((_schedule[*it].name == generatorName)&&(_schedule[*it].generator)) return runSchedule(&positions);
+
+		_error = "libGina : Cannot update : " + generatorName + " is not a registered generator.";
+		return false;
+	}
+
+	bool Scheduler::update(Node* generator)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		return update(getUniqueName(generator));
+	}
+
+	void Scheduler::enableProcessorFusion(bool enabled)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		_fusion = enabled;
+		_scheduleChanged = true;
+	}
+
+	int Scheduler::getChannelsOfTypes(const set<string>& types)
+	{
+		static const char* prefixes[4] = {"LG_SWITCH_","LG_ORIENTEDPOINT1D_","LG_ORIENTEDPOINT2D_","LG_ORIENTEDPOINT3D_"};
+		static const int prefixChannels[4] = {LG_CHANNEL_SWITCH,LG_CHANNEL_1D,LG_CHANNEL_2D,LG_CHANNEL_3D};
+
+		int channels = 0;
+		for(set<string>::const_iterator it = types.begin();it != types.end();it++)
+		{
+			int channel = LG_CHANNEL_ALL;
+			for(int i = 0;i < 4;i++)
+			{
+				if(it->compare(0,strlen(prefixes[i]),prefixes[i]) != 0) continue;
+				channel = prefixChannels[i];
+				break;
+			}
+			channels |= channel;
+		}
+		return (channels == 0) ? LG_CHANNEL_ALL : channels;
+	}
+
+	void Scheduler::setChannels(Node* node,int channels)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		string uniqueName = getUniqueName(node);
+		if(uniqueName.empty()) return;
+		if(channels < 0) _declaredChannels.erase(uniqueName);
+		else _declaredChannels[uniqueName] = channels & LG_CHANNEL_ALL;
+		_scheduleChanged = true;
+	}
+
+	int Scheduler::getChannels(Node* node)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		string uniqueName = getUniqueName(node);
+		if(uniqueName.empty()) return 0;
+		if(_scheduleChanged) buildSchedule();
+		for(vector<ScheduledNode>::iterator it = _schedule.begin();it != _schedule.end();it++)
+			if(it->name == uniqueName) return it->channels;
+		return 0;
+	}
+
+	void Scheduler::setFreshnessBudget(string type,int maxAge)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		if(maxAge < 0) _freshnessBudgets.erase(type);
+		else _freshnessBudgets[type] = maxAge;
+		_scheduleChanged = true;
+	}
+
+	void Scheduler::setFreshnessBudget(Node* generator,int maxAge)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		set<string> types = generator->produce();
+		for(set<string>::iterator it = types.begin();it != types.end();it++)
+			setFreshnessBudget(*it,maxAge);
+	}
+
+	int Scheduler::getFreshnessBudget(string type) const
+	{
+		map<string, int>::const_iterator bit = _freshnessBudgets.find(type);
+		if(bit == _freshnessBudgets.end()) return -1;
+		return bit->second;
+	}
+
+	void Scheduler::enableStatistics(string type,int window,float smoothing)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		disableStatistics(type);
+		_statisticsTypes.insert(make_pair(type,HistoricStatistics(window,smoothing)));
+	}
+
+	template <typename G> void Scheduler::eraseStatistics(GroupSlots<G>& slots,const string& type)
+	{
+		for(size_t i = 0;i < slots.slots.size();i++)
+		{
+			GroupState& state = slots.slots.at(i).state;
+			for(map<string, ElementState>::iterator eit = state.elements.begin();eit != state.elements.end();eit++)
+				if(eit->second.type == type) state.statistics.erase(eit->first);
+		}
+	}
+
+	template <typename G> const Scheduler::GroupState* Scheduler::getGroupState(const GroupSlots<G>& slots,const string& groupID)
+	{
+		const GroupSlot<G>* slot = slots.slots.get(groupID);
+		return (slot == 0) ? 0 : &slot->state;
+	}
+
+	const Scheduler::GroupState* Scheduler::getGroupState(int dimension,const string& groupID) const
+	{
+		switch(dimension)
+		{
+			case 0: return getGroupState(_slotsSwitch,groupID);
+			case 1: return getGroupState(_slots1D,groupID);
+			case 2: return getGroupState(_slots2D,groupID);
+			case 3: return getGroupState(_slots3D,groupID);
+		}
+		return 0;
+	}
+
+	void Scheduler::disableStatistics(string type)
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		if(_statisticsTypes.erase(type) == 0) return;
+
+		eraseStatistics(_slotsSwitch,type);
+		eraseStatistics(_slots1D,type);
+		eraseStatistics(_slots2D,type);
+		eraseStatistics(_slots3D,type);
+	}
+
+	const HistoricStatistics* Scheduler::getStatistics(string groupID,string historicID) const
+	{
+		for(int i = 0;i < 4;i++)
+		{
+			const GroupState* state = getGroupState(i,groupID);
+			if(state == 0) continue;
+			map<string, HistoricStatistics>::const_iterator hsit = state->statistics.find(historicID);
+			if(hsit != state->statistics.end()) return &hsit->second;
+		}
+		return 0;
+	}
+
+	unsigned long Scheduler::getGroupEpoch(string groupID) const
+	{
+		unsigned long epoch = 0;
+		for(int i = 0;i < 4;i++)
+		{
+			const GroupState* state = getGroupState(i,groupID);
+			if((state != 0)&&(state->epoch > epoch)) epoch = state->epoch;
+		}
+		return epoch;
+	}
+
+	unsigned long Scheduler::getVersion(string groupID,string historicID) const
+	{
+		for(int i = 0;i < 4;i++)
+		{
+			const GroupState* state = getGroupState(i,groupID);
+			if(state == 0) continue;
+			map<string, ElementState>::const_iterator eit = state->elements.find(historicID);
+			if(eit != state->elements.end()) return eit->second.version;
+		}
+		return 0;
+	}
+
+	unsigned long Scheduler::getTypeEpoch(string groupID,string type) const
+	{
+		unsigned long epoch = 0;
+		for(int i = 0;i < 4;i++)
+		{
+			const GroupState* state = getGroupState(i,groupID);
+			if(state == 0) continue;
+			map<string, unsigned long>::const_iterator tit = state->types.find(type);
+			if((tit != state->types.end())&&(tit->second > epoch)) epoch = tit->second;
+		}
+		return epoch;
+	}
+
+	bool Scheduler::prepare()
+	{
+		lock_guard<recursive_mutex> lock(_mutex);
+		if(!checkCompatibility()) return false;
+		if(_scheduleChanged) buildSchedule();
+		return true;
+	}
+
+	bool Scheduler::checkCompatibility()
+	{
+		if(_graph.isCompatible()) return true;
+
+		char buffer[512];
+		const map<string, set<string> >& missing = _graph.getMissingProducers();
+		if(!missing.empty())
+		{
+			const string& name = missing.begin()->first;
+			const string& type = *missing.begin()->second.begin();
+			snprintf(buffer,sizeof(buffer),_graph.isConsumed(name,type) ? "libGina : Error : %s node needed %s to consume it." : "libGina : Error : %s node needed %s.",name.c_str(),type.c_str());
+			_error = buffer;
+			return false;
+		}
+
+		snprintf(buffer,sizeof(buffer),"libGina : Error : %s node is part of a cycle.",_graph.getCyclicNodes().begin()->c_str());
+		_error = buffer;
+		return false;
+	}
+
+	string Scheduler::getLastError()
+	{
+		return _error;
+	}
+}
@@ -0,0 +1,224 @@
+#include "LgSharedStatePublisher.h"
+
+#include <algorithm>
+
+namespace lg
+{
+	// Copy a name, cut to the size of the field
+	static void copyName(char* field,size_t size,const string& name)
+	{
+		size_t length = (name.size() < size - 1) ? name.size() : size - 1;
+		memcpy(field,name.c_str(),length);
+		field[length] = '\0';
+	}
+
+	static void copyValue(SharedElement& element,const OrientedPoint3D& value)
+	{
+		Point3D position = value.getPosition();
+		Point3D orientation = value.getOrientation();
+		element.dimension = 3;
+		element.position[0] = position.getX();
+		element.position[1] = position.getY();
+		element.position[2] = position.getZ();
+		element.orientation[0] = orientation.getX();
+		element.orientation[1] = orientation.getY();
+		element.orientation[2] = orientation.getZ();
+		element.confidence = value.getConfidence();
+		element.intensity = value.getIntensity();
+	}
+
+	static void copyValue(SharedElement& element,const OrientedPoint2D& value)
+	{
+		Point2D position = value.getPosition();
+		element.dimension = 2;
+		element.position[0] = position.getX();
+		element.position[1] = position.getY();
+		element.position[2] = 0.0f;
+		element.orientation[0] = value.getOrientation();
+		element.orientation[1] = element.orientation[2] = 0.0f;
+		element.confidence = value.getConfidence();
+		element.intensity = value.getIntensity();
+	}
+
+	static void copyValue(SharedElement& element,const OrientedPoint1D& value)
+	{
+		element.dimension = 1;
+		element.position[0] = value.getPosition();
+		element.position[1] = element.position[2] = 0.0f;
+		element.orientation[0] = value.getOrientation() ? 1.0f : 0.0f;
+		element.orientation[1] = element.orientation[2] = 0.0f;
+		element.confidence = value.getConfidence();
+		element.intensity = value.getIntensity();
+	}
+
+	static void copyValue(SharedElement& element,const Switch& value)
+	{
+		element.dimension = 0;
+		element.position[0] = value.getState() ? 1.0f : 0.0f;
+		element.position[1] = element.position[2] = 0.0f;
+		element.orientation[0] = element.orientation[1] = element.orientation[2] = 0.0f;
+		element.confidence = element.intensity = 1.0f;
+	}
+
+	// Write the last values of the observed Groups and types after the given ones, count the values beyond the capacity
+	template <typename H> static void copyGroups(const Observer& observer,const map<string,GroupTemplate<H>*>& groups,SharedElement* elements,uint32_t capacity,uint32_t& count,uint32_t& dropped)
+	{
+		for(typename map<string,GroupTemplate<H>*>::const_iterator git = groups.begin();git != groups.end();git++)
+		{
+			if(!observer.isObservedGroup(git->first,git->second->getType())) continue;
+			const map<string,H*>& historics = git->second->getAll();
+			for(typename map<string,H*>::const_iterator hit = historics.begin();hit != historics.end();hit++)
+			{
+				H* historic = hit->second;
+				if((historic == 0)||(historic->isEmpty())||(!observer.isObservedType(historic->getType()))) continue;
+				if(count >= capacity)
+				{
+					dropped++;
+					continue;
+				}
+				SharedElement& element = elements[count++];
+				copyName(element.groupID,sizeof(element.groupID),git->first);
+				copyName(element.type,sizeof(element.type),historic->getType());
+				element.timestamp = historic->getLastTimestamp();
+				copyValue(element,*historic->getLast());
+			}
+		}
+	}
+
+	SharedStatePublisher::SharedStatePublisher(string name,string segmentName,uint32_t elementCapacity,uint32_t probabilityCapacity,uint32_t frameCount)
+		: Observer(name),_segmentName(segmentName),_frameCount((frameCount > 2) ? frameCount : 2),_elementCapacity(elementCapacity),_probabilityCapacity(probabilityCapacity),_header(0),_size(0)
+	{
+	}
+
+	SharedStatePublisher::~SharedStatePublisher(void)
+	{
+		if(_header != 0) stop();
+	}
+
+	SharedFrame* SharedStatePublisher::getFrame(uint32_t index) const
+	{
+		return reinterpret_cast<SharedFrame*>(reinterpret_cast<char*>(_header) + getSharedStateAlignedSize(sizeof(SharedStateHeader)) + (size_t)index*_header->frameSize);
+	}
+
+	void SharedStatePublisher::publishProbabilities(const Observer* observer)
+	{
+		if((observer != 0)&&(find(_probabilityNodes.begin(),_probabilityNodes.end(),observer) == _probabilityNodes.end())) _probabilityNodes.push_back(observer);
+	}
+
+	Node* SharedStatePublisher::clone(string cloneName) const
+	{
+		// Each clone needs its own memory, removing the one of another publisher when started
+		string segmentName = _segmentName + "-" + cloneName;
+		replace(segmentName.begin() + 1,segmentName.end(),'/','_');
+		SharedStatePublisher* clone = new SharedStatePublisher(cloneName,segmentName,_elementCapacity,_probabilityCapacity,_frameCount);
+		clone->copyFilters(*this);
+		clone->_probabilityNodes = _probabilityNodes;
+		return clone;
+	}
+
+	bool SharedStatePublisher::start()
+	{
+		if(_header != 0) return true;
+#if defined _WIN32  || defined _WIN64
+		_error = "libGina : Error : shared memory is not supported on this system (" + _segmentName + ").";
+		return false;
+#else
+		size_t frameSize = getSharedStateAlignedSize(getSharedStateAlignedSize(sizeof(SharedFrame)) + _elementCapacity*sizeof(SharedElement) + _probabilityCapacity*sizeof(SharedProbability));
+		size_t size = getSharedStateAlignedSize(sizeof(SharedStateHeader)) + _frameCount*frameSize;
+
+		// A memory left by a publisher which has not been stopped may have another layout : readers mapping it keep it, the new ones get this one
+		shm_unlink(_segmentName.c_str());
+		int descriptor = shm_open(_segmentName.c_str(),O_CREAT|O_EXCL|O_RDWR,0644);
+		if(descriptor < 0)
+		{
+			_error = "libGina : Error : cannot create the shared memory " + _segmentName + ".";
+			return false;
+		}
+		void* memory = MAP_FAILED;
+		if(ftruncate(descriptor,(off_t)size) == 0) memory = mmap(0,size,PROT_READ|PROT_WRITE,MAP_SHARED,descriptor,0);
+		close(descriptor);
+		if(memory == MAP_FAILED)
+		{
+			shm_unlink(_segmentName.c_str());
+			_error = "libGina : Error : cannot map the shared memory " + _segmentName + ".";
+			return false;
+		}
+
+		// The memory is filled with 0 by ftruncate : no frame is published, and all the sequences are even
+		_header = static_cast<SharedStateHeader*>(memory);
+		_size = size;
+		_header->version = LG_SHARED_STATE_VERSION;
+		_header->frameCount = _frameCount;
+		_header->frameSize = (uint32_t)frameSize;
+		_header->elementCapacity = _elementCapacity;
+		_header->probabilityCapacity = _probabilityCapacity;
+		_header->magic.store(LG_SHARED_STATE_MAGIC,memory_order_release);
+		return true;
+#endif
+	}
+
+	bool SharedStatePublisher::stop()
+	{
+#if defined _WIN32  || defined _WIN64
+#else
+		if(_header != 0)
+		{
+			munmap(_header,_size);
+			shm_unlink(_segmentName.c_str());
+		}
+#endif
+		_header = 0;
+		_size = 0;
+		return true;
+	}
+
+	bool SharedStatePublisher::observe(map<string,Group3D*> groups3D,map<string,Group2D*> groups2D,map<string,Group1D*> groups1D,map<string,GroupSwitch*> groupsSwitch)
+	{
+		if(_header == 0)
+		{
+			_error = "libGina : Error : " + getName() + " is not started.";
+			return false;
+		}
+
+		// Seqlock : the sequence of the frame is odd while it is written, the readers check it did not change while reading
+		uint32_t published = _header->published.load(memory_order_relaxed);
+		SharedFrame* frame = getFrame(published % _frameCount);
+		frame->sequence.store(2*published + 1,memory_order_relaxed);
+		atomic_thread_fence(memory_order_release);
+
+		SharedElement* elements = const_cast<SharedElement*>(getSharedElements(frame));
+		uint32_t count = 0;
+		uint32_t dropped = 0;
+		copyGroups(*this,groups3D,elements,_elementCapacity,count,dropped);
+		copyGroups(*this,groups2D,elements,_elementCapacity,count,dropped);
+		copyGroups(*this,groups1D,elements,_elementCapacity,count,dropped);
+		copyGroups(*this,groupsSwitch,elements,_elementCapacity,count,dropped);
+		frame->elementCount = count;
+
+		SharedProbability* probabilities = const_cast<SharedProbability*>(getSharedProbabilities(frame,_elementCapacity));
+		count = 0;
+		for(vector<const Observer*>::iterator nit = _probabilityNodes.begin();nit != _probabilityNodes.end();nit++)
+		{
+			map<string, float> nodeProbabilities = (*nit)->getProbabilities();
+			for(map<string, float>::iterator pit = nodeProbabilities.begin();pit != nodeProbabilities.end();pit++)
+			{
+				if(count >= _probabilityCapacity)
+				{
+					dropped++;
+					continue;
+				}
+				SharedProbability& probability = probabilities[count++];
+				copyName(probability.nodeName,sizeof(probability.nodeName),(*nit)->getName());
+				copyName(probability.groupID,sizeof(probability.groupID),pit->first);
+				probability.probability = pit->second;
+			}
+		}
+		frame->probabilityCount = count;
+		frame->droppedCount = dropped;
+		frame->timestamp = getTime();
+
+		frame->sequence.store(2*published + 2,memory_order_release);
+		_header->published.store(published + 1,memory_order_release);
+		return true;
+	}
+}
@@ -0,0 +1,120 @@
+#include "LgStatistics.h"
+
+#include <math.h>
+
+namespace lg
+{
+	RunningStatistics::RunningStatistics(int window,float smoothing) : _window((window > 0) ? window : 1),_smoothing(smoothing),_added(0),_sum(0.0),_mean(0.0),_m2(0.0),_average(0.0),_previousAverage(0.0)
+	{
+	}
+
+	void RunningStatistics::addMoments(float value)
+	{
+		_sum += value;
+		double delta = value - _mean;
+		_mean += delta/(double)_values.size();
+		_m2 += delta*(value - _mean);
+	}
+
+	void RunningStatistics::removeMoments(float value)
+	{
+		// _values already holds one value less
+		_sum -= value;
+		if(_values.empty())
+		{
+			_sum = 0.0;
+			_mean = 0.0;
+			_m2 = 0.0;
+			return;
+		}
+		double previousMean = _mean;
+		_mean = (previousMean*(double)(_values.size() + 1) - value)/(double)_values.size();
+		_m2 -= (value - previousMean)*(value - _mean);
+		if(_m2 < 0.0) _m2 = 0.0;
+	}
+
+	void RunningStatistics::pushExtrema(float value)
+	{
+		unsigned long index = _added - 1;
+		unsigned long oldest = (_added > (unsigned long)_window) ? _added - _window : 0;
+
+		while((!_minima.empty())&&(_minima.back().second >= value)) _minima.pop_back();
+		_minima.push_back(make_pair(index,value));
+		while(_minima.front().first < oldest) _minima.pop_front();
+
+		while((!_maxima.empty())&&(_maxima.back().second <= value)) _maxima.pop_back();
+		_maxima.push_back(make_pair(index,value));
+		while(_maxima.front().first < oldest) _maxima.pop_front();
+	}
+
+	void RunningStatistics::add(float value)
+	{
+		if((int)_values.size() == _window)
+		{
+			float oldest = _values.front();
+			_values.pop_front();
+			removeMoments(oldest);
+		}
+		_values.push_back(value);
+		addMoments(value);
+
+		_added++;
+		pushExtrema(value);
+
+		_previousAverage = _average;
+		_average = (_added == 1) ? value : _average + _smoothing*(value - _average);
+	}
+
+	void RunningStatistics::replaceLast(float value)
+	{
+		if(_values.empty())
+		{
+			add(value);
+			return;
+		}
+
+		float last = _values.back();
+		_values.pop_back();
+		removeMoments(last);
+		_values.push_back(value);
+		addMoments(value);
+
+		// The replaced value may have dropped candidates from the queues : rebuild them from the window
+		_minima.clear();
+		_maxima.clear();
+		unsigned long added = _added;
+		_added -= _values.size();
+		for(deque<float>::iterator it = _values.begin();it != _values.end();it++)
+		{
+			_added++;
+			pushExtrema(*it);
+		}
+		_added = added;
+
+		_average = (_added == 1) ? value : _previousAverage + _smoothing*(value - _previousAverage);
+	}
+
+	void RunningStatistics::clear()
+	{
+		_values.clear();
+		_minima.clear();
+		_maxima.clear();
+		_added = 0;
+		_sum = 0.0;
+		_mean = 0.0;
+		_m2 = 0.0;
+		_average = 0.0;
+		_previousAverage = 0.0;
+	}
+
+	float RunningStatistics::getVariance() const
+	{
+		if(_values.size() < 2) return 0.0f;
+		return (float)(_m2/(double)_values.size());
+	}
+
+	float RunningStatistics::getStandardDeviation() const
+	{
+		return (float)sqrt(getVariance());
+	}
+}
@@ -0,0 +1,103 @@
+#include "LgThreadPool.h"
+
+namespace lg
+{
+	ThreadPool::ThreadPool(size_t threadNumber) : _batch(0),_stopping(false),_function(0),_context(0),_remaining(0)
+	{
+		size_t queueNumber = (threadNumber > 0) ? threadNumber : 1;
+		for(size_t i = 0;i < queueNumber;i++) _queues.push_back(new TaskQueue());
+		for(size_t i = 0;i + 1 < queueNumber;i++) _threads.push_back(thread(&ThreadPool::work,this,i));
+	}
+
+	ThreadPool::~ThreadPool(void)
+	{
+		{
+			lock_guard<mutex> lock(_mutex);
+			_stopping = true;
+		}
+		_batchStarted.notify_all();
+		for(vector<thread>::iterator it = _threads.begin();it != _threads.end();it++) it->join();
+		for(vector<TaskQueue*>::iterator it = _queues.begin();it != _queues.end();it++) delete *it;
+	}
+
+	void ThreadPool::work(size_t index)
+	{
+		unsigned long batch = 0;
+		while(true)
+		{
+			{
+				unique_lock<mutex> lock(_mutex);
+				while((!_stopping)&&(_batch == batch)) _batchStarted.wait(lock);
+				if(_stopping) return;
+				batch = _batch;
+			}
+
+			// No task is added during a batch : once all the queues are empty, the thread waits for the next batch
+			while(runTask(index));
+		}
+	}
+
+	bool ThreadPool::runTask(size_t index)
+	{
+		size_t task = 0;
+		bool found = false;
+		{
+			lock_guard<mutex> lock(_queues[index]->lock);
+			if(!_queues[index]->tasks.empty())
+			{
+				task = _queues[index]->tasks.front();
+				_queues[index]->tasks.pop_front();
+				found = true;
+			}
+		}
+
+		// Steal from the back of the other queues, starting with the next one so the thieves spread
+		for(size_t i = 1;(!found)&&(i < _queues.size());i++)
+		{
+			TaskQueue* victim = _queues[(index + i) % _queues.size()];
+			lock_guard<mutex> lock(victim->lock);
+			if(victim->tasks.empty()) continue;
+			task = victim->tasks.back();
+			victim->tasks.pop_back();
+			found = true;
+		}
+		if(!found) return false;
+
+		_function(task,_context);
+		if(--_remaining == 0)
+		{
+			lock_guard<mutex> lock(_mutex);
+			_batchFinished.notify_all();
+		}
+		return true;
+	}
+
+	void ThreadPool::run(size_t taskNumber,TaskFunction* function,void* context)
+	{
+		if(taskNumber == 0) return;
+		lock_guard<mutex> runLock(_runMutex);
+
+		{
+			lock_guard<mutex> lock(_mutex);
+			_function = function;
+			_context = context;
+			_remaining = taskNumber;
+
+			// Contiguous blocks of tasks, so neighbouring tasks run on the same thread unless stolen
+			size_t queueNumber = _queues.size();
+			for(size_t q = 0;q < queueNumber;q++)
+			{
+				lock_guard<mutex> queueLock(_queues[q]->lock);
+				for(size_t i = taskNumber*q/queueNumber;i < taskNumber*(q + 1)/queueNumber;i++) _queues[q]->tasks.push_back(i);
+			}
+			_batch++;
+		}
+		_batchStarted.notify_all();
+
+		// The calling thread runs its own queue, then helps the others
+		while(runTask(_queues.size() - 1));
+
+		unique_lock<mutex> lock(_mutex);
+		while(_remaining > 0) _batchFinished.wait(lock);
+	}
+}
@@ -0,0 +1,364 @@
+#include "LgUdpStreamer.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <algorithm>
+
+#if defined _WIN32  || defined _WIN64
+#else
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+
+namespace lg
+{
+	// Size of the header of a datagram (OSC bundle, or binary header)
+	static const size_t datagramHeaderSize = 16;
+
+	static void putInt32(vector<char>& record,uint32_t value)
+	{
+		record.push_back((char)(value >> 24));
+		record.push_back((char)(value >> 16));
+		record.push_back((char)(value >> 8));
+		record.push_back((char)value);
+	}
+
+	static void putFloat(vector<char>& record,float value)
+	{
+		uint32_t bits;
+		memcpy(&bits,&value,sizeof(bits));
+		putInt32(record,bits);
+	}
+
+	static void putText(vector<char>& record,const string& text,size_t length)
+	{
+		record.insert(record.end(),text.c_str(),text.c_str() + length);
+	}
+
+	// Pad with '\0' to a multiple of 4 bytes (OSC strings end with at least one '\0')
+	static void padRecord(vector<char>& record,bool terminated)
+	{
+		if(terminated) record.push_back('\0');
+		while(record.size() % 4 != 0) record.push_back('\0');
+	}
+
+	static void writeUint16(char* data,uint16_t value)
+	{
+		data[0] = (char)(value >> 8);
+		data[1] = (char)value;
+	}
+
+	static void writeUint32(char* data,uint32_t value)
+	{
+		writeUint16(data,(uint16_t)(value >> 16));
+		writeUint16(data + 2,(uint16_t)value);
+	}
+
+	// Values of a point : position, orientation, confidence and intensity
+	static int getValues(const OrientedPoint3D& value,float* values,int& dimension)
+	{
+		Point3D position = value.getPosition();
+		Point3D orientation = value.getOrientation();
+		dimension = 3;
+		values[0] = position.getX();
+		values[1] = position.getY();
+		values[2] = position.getZ();
+		values[3] = orientation.getX();
+		values[4] = orientation.getY();
+		values[5] = orientation.getZ();
+		values[6] = value.getConfidence();
+		values[7] = value.getIntensity();
+		return 8;
+	}
+
+	static int getValues(const OrientedPoint2D& value,float* values,int& dimension)
+	{
+		Point2D position = value.getPosition();
+		dimension = 2;
+		values[0] = position.getX();
+		values[1] = position.getY();
+		values[2] = value.getOrientation();
+		values[3] = value.getConfidence();
+		values[4] = value.getIntensity();
+		return 5;
+	}
+
+	static int getValues(const OrientedPoint1D& value,float* values,int& dimension)
+	{
+		dimension = 1;
+		values[0] = value.getPosition();
+		values[1] = value.getOrientation() ? 1.0f : 0.0f;
+		values[2] = value.getConfidence();
+		values[3] = value.getIntensity();
+		return 4;
+	}
+
+	static int getValues(const Switch& value,float* values,int& dimension)
+	{
+		dimension = 0;
+		values[0] = value.getState() ? 1.0f : 0.0f;
+		return 1;
+	}
+
+	UdpStreamer::UdpStreamer(string name,string host,int port,int format,size_t datagramSize,size_t datagramCapacity)
+		: Observer(name),_host(host),_port(port),_format(format),_addressPrefix("/lg"),_datagramSize((datagramSize > 64) ? datagramSize : 64),
+		_datagramCapacity((datagramCapacity > 0) ? datagramCapacity : 1),_socket(-1),_datagramCount(0),_frame(0),_sentDatagrams(0),_droppedDatagrams(0),_droppedValues(0)
+	{
+	}
+
+	UdpStreamer::~UdpStreamer(void)
+	{
+		if(_socket >= 0) stop();
+	}
+
+	void UdpStreamer::publishProbabilities(const Observer* observer)
+	{
+		if((observer != 0)&&(find(_probabilityNodes.begin(),_probabilityNodes.end(),observer) == _probabilityNodes.end())) _probabilityNodes.push_back(observer);
+	}
+
+	Node* UdpStreamer::clone(string cloneName) const
+	{
+		UdpStreamer* clone = new UdpStreamer(cloneName,_host,_port,_format,_datagramSize,_datagramCapacity);
+		clone->copyFilters(*this);
+		clone->_addressPrefix = _addressPrefix;
+		clone->_probabilityNodes = _probabilityNodes;
+		return clone;
+	}
+
+	bool UdpStreamer::start()
+	{
+		if(_socket >= 0) return true;
+#if defined _WIN32  || defined _WIN64
+		_error = "libGina : Error : UDP streaming is not supported on this system.";
+		return false;
+#else
+		memset(&_address,0,sizeof(_address));
+		_address.sin_family = AF_INET;
+		_address.sin_port = htons((uint16_t)_port);
+		if((_port <= 0)||(_port > 65535)||(inet_pton(AF_INET,_host.c_str(),&_address.sin_addr) != 1))
+		{
+			_error = "libGina : Error : invalid UDP endpoint " + _host + ".";
+			return false;
+		}
+		_socket = socket(AF_INET,SOCK_DGRAM,0);
+		if(_socket < 0)
+		{
+			_error = "libGina : Error : cannot create an UDP socket (" + string(strerror(errno)) + ").";
+			return false;
+		}
+
+		// Everything sent at each update is allocated here
+		_buffers.assign(_datagramCapacity*_datagramSize,0);
+		_lengths.assign(_datagramCapacity,0);
+		_record.reserve(_datagramSize);
+#ifdef __linux__
+		_vectors.resize(_datagramCapacity);
+		_messages.resize(_datagramCapacity);
+		for(size_t i = 0;i < _datagramCapacity;i++)
+		{
+			_vectors[i].iov_base = &_buffers[i*_datagramSize];
+			_vectors[i].iov_len = 0;
+			memset(&_messages[i],0,sizeof(_messages[i]));
+			_messages[i].msg_hdr.msg_name = &_address;
+			_messages[i].msg_hdr.msg_namelen = sizeof(_address);
+			_messages[i].msg_hdr.msg_iov = &_vectors[i];
+			_messages[i].msg_hdr.msg_iovlen = 1;
+		}
+#endif
+		return true;
+#endif
+	}
+
+	bool UdpStreamer::stop()
+	{
+#if defined _WIN32  || defined _WIN64
+#else
+		if(_socket >= 0) close(_socket);
+#endif
+		_socket = -1;
+		return true;
+	}
+
+	bool UdpStreamer::appendRecord()
+	{
+		size_t size = _record.size() + ((_format == LG_STREAM_OSC) ? 4 : 0);
+		if((_datagramCount == 0)||(_lengths[_datagramCount - 1] + size > _datagramSize))
+		{
+			if((_datagramCount >= _datagramCapacity)||(datagramHeaderSize + size > _datagramSize))
+			{
+				_droppedValues++;
+				return false;
+			}
+
+			// OSC bundle with the time tag "immediately", or binary header (the number of datagrams is written once known)
+			char* datagram = &_buffers[_datagramCount*_datagramSize];
+			if(_format == LG_STREAM_OSC)
+			{
+				memcpy(datagram,"#bundle\0",8);
+				writeUint32(datagram + 8,0);
+				writeUint32(datagram + 12,1);
+			}
+			else
+			{
+				writeUint32(datagram,LG_STREAM_MAGIC);
+				writeUint32(datagram + 4,_frame);
+				writeUint32(datagram + 8,(uint32_t)getTime());
+				writeUint16(datagram + 12,(uint16_t)_datagramCount);
+			}
+			_lengths[_datagramCount++] = datagramHeaderSize;
+		}
+
+		char* datagram = &_buffers[(_datagramCount - 1)*_datagramSize];
+		size_t& length = _lengths[_datagramCount - 1];
+		if(_format == LG_STREAM_OSC)
+		{
+			writeUint32(datagram + length,(uint32_t)_record.size());
+			length += 4;
+		}
+		memcpy(datagram + length,&_record[0],_record.size());
+		length += _record.size();
+		return true;
+	}
+
+	void UdpStreamer::serializeValue(const string& groupID,const string& type,int dimension,int timestamp,const float* values,int count)
+	{
+		_record.clear();
+		if(_format == LG_STREAM_OSC)
+		{
+			putText(_record,_addressPrefix,_addressPrefix.size());
+			_record.push_back('/');
+			putText(_record,groupID,groupID.size());
+			_record.push_back('/');
+			putText(_record,type,type.size());
+			padRecord(_record,true);
+			_record.push_back(',');
+			_record.push_back('i');
+			_record.insert(_record.end(),count,'f');
+			padRecord(_record,true);
+		}
+		else
+		{
+			size_t idLength = (groupID.size() < 255) ? groupID.size() : 255;
+			size_t typeLength = (type.size() < 255) ? type.size() : 255;
+			_record.push_back((char)dimension);
+			_record.push_back((char)idLength);
+			_record.push_back((char)typeLength);
+			_record.push_back('\0');
+			putText(_record,groupID,idLength);
+			putText(_record,type,typeLength);
+			padRecord(_record,false);
+		}
+		putInt32(_record,(uint32_t)timestamp);
+		for(int i = 0;i < count;i++) putFloat(_record,values[i]);
+	}
+
+	void UdpStreamer::serializeProbability(const string& nodeName,const string& groupID,float probability)
+	{
+		_record.clear();
+		if(_format == LG_STREAM_OSC)
+		{
+			putText(_record,_addressPrefix,_addressPrefix.size());
+			putText(_record,"/probability/",13);
+			putText(_record,nodeName,nodeName.size());
+			_record.push_back('/');
+			putText(_record,groupID,groupID.size());
+			padRecord(_record,true);
+			putText(_record,",f",2);
+			padRecord(_record,true);
+		}
+		else
+		{
+			size_t nameLength = (nodeName.size() < 255) ? nodeName.size() : 255;
+			size_t idLength = (groupID.size() < 255) ? groupID.size() : 255;
+			_record.push_back((char)LG_STREAM_PROBABILITY);
+			_record.push_back((char)nameLength);
+			_record.push_back((char)idLength);
+			_record.push_back('\0');
+			putText(_record,nodeName,nameLength);
+			putText(_record,groupID,idLength);
+			padRecord(_record,false);
+		}
+		putFloat(_record,probability);
+	}
+
+	template <typename H> void UdpStreamer::serializeGroups(const map<string,GroupTemplate<H>*>& groups)
+	{
+		float values[8];
+		int dimension;
+		for(typename map<string,GroupTemplate<H>*>::const_iterator git = groups.begin();git != groups.end();git++)
+		{
+			if(!isObservedGroup(git->first,git->second->getType())) continue;
+			const map<string,H*>& historics = git->second->getAll();
+			for(typename map<string,H*>::const_iterator hit = historics.begin();hit != historics.end();hit++)
+			{
+				H* historic = hit->second;
+				if((historic == 0)||(historic->isEmpty())||(!isObservedType(historic->getType()))) continue;
+				int count = getValues(*historic->getLast(),values,dimension);
+				serializeValue(git->first,historic->getType(),dimension,historic->getLastTimestamp(),values,count);
+				appendRecord();
+			}
+		}
+	}
+
+	void UdpStreamer::sendDatagrams()
+	{
+		size_t sent = 0;
+		int failure = 0;
+#if defined _WIN32  || defined _WIN64
+#elif defined __linux__
+		for(size_t i = 0;i < _datagramCount;i++) _vectors[i].iov_len = _lengths[i];
+		while(sent < _datagramCount)
+		{
+			int result = sendmmsg(_socket,&_messages[sent],(unsigned int)(_datagramCount - sent),MSG_DONTWAIT);
+			if((result < 0)&&(errno == EINTR)) continue;
+			if(result <= 0)
+			{
+				failure = (result < 0) ? errno : EAGAIN;
+				break;
+			}
+			sent += result;
+		}
+#else
+		for(size_t i = 0;i < _datagramCount;i++)
+		{
+			if(sendto(_socket,&_buffers[i*_datagramSize],_lengths[i],MSG_DONTWAIT,(const struct sockaddr*)&_address,sizeof(_address)) >= 0) sent++;
+			else failure = errno;
+		}
+#endif
+		// errno is read where the send failed, later calls may overwrite it
+		if(sent < _datagramCount) _error = "libGina : Error : datagrams dropped by the system (" + string(strerror(failure)) + ").";
+		_sentDatagrams += sent;
+		_droppedDatagrams += _datagramCount - sent;
+	}
+
+	bool UdpStreamer::observe(map<string,Group3D*> groups3D,map<string,Group2D*> groups2D,map<string,Group1D*> groups1D,map<string,GroupSwitch*> groupsSwitch)
+	{
+		if(_socket < 0)
+		{
+			_error = "libGina : Error : " + getName() + " is not started.";
+			return false;
+		}
+
+		_datagramCount = 0;
+		serializeGroups(groups3D);
+		serializeGroups(groups2D);
+		serializeGroups(groups1D);
+		serializeGroups(groupsSwitch);
+		for(vector<const Observer*>::iterator nit = _probabilityNodes.begin();nit != _probabilityNodes.end();nit++)
+		{
+			map<string, float> probabilities = (*nit)->getProbabilities();
+			for(map<string, float>::iterator pit = probabilities.begin();pit != probabilities.end();pit++)
+			{
+				serializeProbability((*nit)->getName(),pit->first,pit->second);
+				appendRecord();
+			}
+		}
+
+		if(_format == LG_STREAM_BINARY)
+			for(size_t i = 0;i < _datagramCount;i++) writeUint16(&_buffers[i*_datagramSize] + 14,(uint16_t)_datagramCount);
+		sendDatagrams();
+		_frame++;
+		return true;
+	}
+}
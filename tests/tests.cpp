@@ -0,0 +1,566 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "LgFilters.h"
+#include "LgGenerator.h"
+#include "LgGroupSlotMap.h"
+#include "LgLeapGenerator.h"
+#include "LgProcessor.h"
+#include "LgScheduler.h"
+#include "LgSharedState.h"
+#include "LgSharedStatePublisher.h"
+#include "LgStatistics.h"
+#include "LgUdpStreamer.h"
+
+#if defined _WIN32  || defined _WIN64
+#else
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+using namespace lg;
+
+static int failures = 0;
+
+static void check(bool condition,const char* text,const char* file,int line)
+{
+    if(condition) return;
+    printf("%s:%d : check failed : %s\n",file,line,text);
+    failures++;
+}
+
+#define LG_CHECK(condition) check((condition),#condition,__FILE__,__LINE__)
+
+// Processor declaring the given types, doing nothing
+class TypedProcessor : public Processor
+{
+private:
+    set<string> _need;
+    set<string> _consume;
+    set<string> _produce;
+
+public:
+    TypedProcessor(string name,const string& need,const string& consume,const string& produce) : Processor(name)
+    {
+        if(!need.empty()) _need.insert(need);
+        if(!consume.empty()) _consume.insert(consume);
+        if(!produce.empty()) _produce.insert(produce);
+    }
+
+    Node* clone(string cloneName) const {return new TypedProcessor(cloneName,string(),string(),string());}
+    bool start() {return true;}
+    bool stop() {return true;}
+    bool update(map<string,Group3D*>&,map<string,Group2D*>&,map<string,Group1D*>&,map<string,GroupSwitch*>&) {return true;}
+    set<string> need() const {return _need;}
+    set<string> consume() const {return _consume;}
+    set<string> produce() const {return _produce;}
+};
+
+// Generator moving the head of the Group A at each update, and the head of the Group B every three updates
+class HeadGenerator : public Generator
+{
+private:
+    int _count;
+
+public:
+    HeadGenerator() : Generator("heads"),_count(0) {}
+
+    Node* clone(string) const {return 0;}
+    bool start() {return true;}
+    bool stop() {return true;}
+    set<string> produce() const {set<string> types;types.insert(LG_ORIENTEDPOINT3D_HEAD);return types;}
+
+    bool generate(map<string,Group3D*>& groups3D,map<string,Group2D*>&,map<string,Group1D*>&,map<string,GroupSwitch*>&)
+    {
+        _count++;
+        updateData(_environment,groups3D,"A","user",LG_ORIENTEDPOINT3D_HEAD,LG_ORIENTEDPOINT3D_HEAD,10*_count,OrientedPoint3D(Point3D(_count,0,0),Point3D(),1,1));
+        if(_count % 3 == 0)
+            updateData(_environment,groups3D,"B","user",LG_ORIENTEDPOINT3D_HEAD,LG_ORIENTEDPOINT3D_HEAD,10*_count,OrientedPoint3D(Point3D(_count,2*_count,0),Point3D(),1,1));
+        return true;
+    }
+};
+
+static void testCompatibilityGraph()
+{
+    TypedProcessor source("source","","","T");
+    TypedProcessor reader("reader","T","","");
+    TypedProcessor consumer("consumer","","T","");
+    TypedProcessor filter("filter","","T","T");
+
+    // A needed type must be produced by a Node of a lower priority
+    CompatibilityGraph graph;
+    LG_CHECK(graph.addNode("reader",&reader,5));
+    LG_CHECK(!graph.isCompatible());
+    LG_CHECK(graph.addNode("source",&source,1));
+    LG_CHECK(graph.isCompatible());
+    LG_CHECK(!graph.addNode("other",&reader,5));
+    LG_CHECK(graph.getSuccessors("source").count("reader") == 1);
+
+    graph.clear();
+    LG_CHECK(graph.addNode("source",&source,7));
+    LG_CHECK(graph.addNode("reader",&reader,5));
+    LG_CHECK(graph.getMissingProducers().count("reader") == 1);
+    LG_CHECK(graph.getSuccessors("source").empty());
+
+    // A consumed type is no longer available, unless it is produced again (in place)
+    graph.clear();
+    LG_CHECK(graph.addNode("source",&source,1));
+    LG_CHECK(graph.addNode("reader",&reader,5));
+    LG_CHECK(graph.addNode("consumer",&consumer,3));
+    LG_CHECK(!graph.isCompatible());
+    LG_CHECK(graph.isConsumed("consumer","T"));
+    LG_CHECK(graph.getSuccessors("source").count("reader") == 0);
+    LG_CHECK(graph.removeNode("consumer"));
+    LG_CHECK(graph.isCompatible());
+    LG_CHECK(graph.addNode("filter",&filter,3));
+    LG_CHECK(graph.isCompatible());
+    LG_CHECK(graph.getSuccessors("source").count("reader") == 1);
+    LG_CHECK(graph.getSuccessors("filter").count("reader") == 1);
+
+    // Cycles of types are only rejected on demand
+    TypedProcessor loopSource("loopSource","","","U");
+    TypedProcessor forward("forward","U","","V");
+    TypedProcessor backward("backward","V","","U");
+    graph.clear();
+    LG_CHECK(graph.addNode("loopSource",&loopSource,0));
+    LG_CHECK(graph.addNode("forward",&forward,1));
+    LG_CHECK(graph.addNode("backward",&backward,2));
+    LG_CHECK(graph.isCompatible());
+    graph.enableCycleRejection(true);
+    LG_CHECK(!graph.isCompatible());
+    LG_CHECK(graph.getCyclicNodes().count("forward") == 1);
+    LG_CHECK(graph.removeNode("backward"));
+    LG_CHECK(graph.isCompatible());
+}
+
+static void testGroupSlotMap()
+{
+    GroupSlotMap<int> slots;
+    GroupHandle a = slots.insert("a",1);
+    GroupHandle b = slots.insert("b",2);
+    GroupHandle c = slots.insert("c",3);
+    LG_CHECK(slots.size() == 3);
+    LG_CHECK(slots.find("b") == b);
+    LG_CHECK(*slots.get(c) == 3);
+    LG_CHECK(!slots.find("d").isSet());
+
+    // Removing a value moves the last one in its place, the handles stay valid
+    LG_CHECK(slots.erase(a));
+    LG_CHECK(!slots.isValid(a));
+    LG_CHECK(slots.get(a) == 0);
+    LG_CHECK(slots.size() == 2);
+    LG_CHECK(slots.idAt(0) == "c");
+    LG_CHECK(*slots.get(b) == 2);
+    LG_CHECK(*slots.get(c) == 3);
+    LG_CHECK(*slots.idOf(c) == "c");
+    LG_CHECK(slots.handleAt(0) == c);
+
+    // A reused slot gives a new handle, the old one stays rejected
+    GroupHandle d = slots.insert("d",4);
+    LG_CHECK(d.index == a.index);
+    LG_CHECK(d != a);
+    LG_CHECK(slots.get(a) == 0);
+    LG_CHECK(slots.idOf(a) == 0);
+    LG_CHECK(slots.insert("d",5) == d);
+    LG_CHECK(*slots.get("d") == 5);
+    slots["e"] = 6;
+    LG_CHECK(*slots.get("e") == 6);
+
+    slots.clear();
+    LG_CHECK(slots.empty());
+    LG_CHECK(!slots.isValid(b));
+}
+
+static void testHistoricStatistics()
+{
+    map<int,float> historic;
+    historic[10] = 1.0f;
+    historic[20] = 2.0f;
+    historic[30] = 3.0f;
+
+    HistoricStatistics statistics(3,0.5f);
+    statistics.update(historic);
+    LG_CHECK(statistics.getDimension() == 1);
+    LG_CHECK(statistics.getLastTimestamp() == 30);
+    LG_CHECK(statistics.get(0).getCount() == 3);
+    LG_CHECK(fabs(statistics.get(0).getMean() - 2.0f) < 1e-5f);
+    LG_CHECK(statistics.get(0).getMin() == 1.0f);
+    LG_CHECK(statistics.get(0).getMax() == 3.0f);
+
+    // Only the new values are read, the window slides
+    historic.erase(10);
+    historic[40] = 7.0f;
+    statistics.update(historic);
+    LG_CHECK(statistics.get(0).getCount() == 3);
+    LG_CHECK(fabs(statistics.get(0).getMean() - 4.0f) < 1e-5f);
+    LG_CHECK(statistics.get(0).getMin() == 2.0f);
+
+    // A value rewritten at the last timestamp replaces the previous one
+    historic[40] = 1.0f;
+    statistics.update(historic);
+    LG_CHECK(statistics.get(0).getCount() == 3);
+    LG_CHECK(fabs(statistics.get(0).getMean() - 2.0f) < 1e-5f);
+    LG_CHECK(statistics.get(0).getMin() == 1.0f);
+    LG_CHECK(statistics.get(0).getMax() == 3.0f);
+}
+
+static void testHistoricWindow()
+{
+    set<string> types;
+    types.insert(LG_ORIENTEDPOINT3D_HEAD);
+
+    // A window longer than the run keeps every value, beyond LG_HISTORIC_WINDOW_LENGTH
+    Environment* environment = new Environment();
+    Scheduler* scheduler = new Scheduler(environment);
+    HeadGenerator* generator = new HeadGenerator();
+    scheduler->setHistoricWindow(LG_ORIENTEDPOINT3D_HEAD,1000000000);
+    LG_CHECK(scheduler->registerNode(generator));
+    LG_CHECK(scheduler->start());
+    for(int i = 0;i < 3*LG_HISTORIC_WINDOW_LENGTH/2;i++) LG_CHECK(scheduler->update());
+
+    map<string, Group3D*>::const_iterator git = scheduler->getGroups3D().find("A");
+    LG_CHECK(git != scheduler->getGroups3D().end());
+    if(git != scheduler->getGroups3D().end())
+    {
+        map<string, HOrientedPoint3D*> elements = git->second->getAll();
+        LG_CHECK(elements.size() == 1);
+        LG_CHECK(elements.begin()->second->getHistoric().size() == 3*LG_HISTORIC_WINDOW_LENGTH/2);
+    }
+    LG_CHECK(environment->getHistoricLength() >= 3*LG_HISTORIC_WINDOW_LENGTH/2);
+    LG_CHECK(scheduler->getMetrics().truncatedWindows == 0);
+
+    scheduler->stop();
+    delete scheduler;
+    delete environment;
+    delete generator;
+}
+
+static float getProcessedX(Scheduler* scheduler,const string& groupID)
+{
+    map<string, Group3D*>::const_iterator git = scheduler->getGroups3D().find(groupID);
+    if(git == scheduler->getGroups3D().end()) return -1.0f;
+    map<string, HOrientedPoint3D*> elements = git->second->getAll();
+    map<string, HOrientedPoint3D*>::iterator eit = elements.find(string(LG_ORIENTEDPOINT3D_HEAD) + LG_FILTER_OUTPUT_SUFFIX);
+    if((eit == elements.end())||(eit->second->isEmpty())) return -1.0f;
+    return eit->second->getLast()->getPosition().getX();
+}
+
+static void testFilterRetention()
+{
+    set<string> types;
+    types.insert(LG_ORIENTEDPOINT3D_HEAD);
+
+    // With dirty tracking, the filter only receives B every three updates and must keep its state in between
+    Environment* environment = new Environment();
+    Scheduler* scheduler = new Scheduler(environment);
+    scheduler->enableDirtyTracking(true);
+    HeadGenerator* generator = new HeadGenerator();
+    MovingAverageProcessor* filter = new MovingAverageProcessor("average",types,3);
+    LG_CHECK(scheduler->registerNode(generator));
+    LG_CHECK(scheduler->registerNode(filter));
+    LG_CHECK(scheduler->start());
+
+    for(int i = 0;i < 3;i++) LG_CHECK(scheduler->update());
+    LG_CHECK(fabs(getProcessedX(scheduler,"B") - 3.0f) < 1e-5f);
+    for(int i = 0;i < 3;i++) LG_CHECK(scheduler->update());
+    LG_CHECK(fabs(getProcessedX(scheduler,"B") - 4.5f) < 1e-5f);
+    for(int i = 0;i < 3;i++) LG_CHECK(scheduler->update());
+    LG_CHECK(fabs(getProcessedX(scheduler,"B") - 6.0f) < 1e-5f);
+    LG_CHECK(fabs(getProcessedX(scheduler,"A") - 8.0f) < 1e-5f);
+
+    scheduler->stop();
+    delete scheduler;
+    delete environment;
+    delete filter;
+    delete generator;
+}
+
+static void testSharedState()
+{
+    Environment* environment = new Environment();
+    Scheduler* scheduler = new Scheduler(environment);
+    HeadGenerator* generator = new HeadGenerator();
+    SharedStatePublisher* publisher = new SharedStatePublisher("publisher","/libginatests");
+    LG_CHECK(scheduler->registerNode(generator));
+    LG_CHECK(scheduler->registerNode(publisher));
+    LG_CHECK(scheduler->start());
+    for(int i = 0;i < 3;i++) LG_CHECK(scheduler->update());
+
+    // The last frame holds the last value of the head of each Group
+    SharedStateReader reader;
+    LG_CHECK(reader.open("/libginatests"));
+    LG_CHECK(reader.getPublishedCount() == 3);
+    vector<SharedElement> elements;
+    vector<SharedProbability> probabilities;
+    int timestamp = -1;
+    LG_CHECK(reader.copyLastFrame(elements,probabilities,timestamp));
+    LG_CHECK(elements.size() == 2);
+    LG_CHECK(probabilities.empty());
+    for(size_t i = 0;i < elements.size();i++)
+    {
+        const SharedElement& element = elements[i];
+        bool b = (strcmp(element.groupID,"B") == 0);
+        LG_CHECK(b || (strcmp(element.groupID,"A") == 0));
+        LG_CHECK(strcmp(element.type,LG_ORIENTEDPOINT3D_HEAD) == 0);
+        LG_CHECK(element.dimension == 3);
+        LG_CHECK(element.timestamp == 30);
+        LG_CHECK(element.position[0] == 3.0f);
+        LG_CHECK(element.position[1] == (b ? 6.0f : 0.0f));
+        LG_CHECK(element.confidence == 1.0f);
+    }
+
+    scheduler->stop();
+    delete scheduler;
+    delete environment;
+    delete publisher;
+    delete generator;
+}
+
+// Hand of a frame pushed in the MockLeapSource, with joint j at (base + j,2*j,-j) and orientation (0,0,j/10)
+static LeapHandSample makeHand(int id,bool right,float base)
+{
+    LeapHandSample hand;
+    hand.id = id;
+    hand.right = right;
+    hand.confidence = 0.5f;
+    for(int joint = 0;joint < LG_LEAP_JOINT_COUNT;joint++)
+    {
+        hand.positions[joint] = Point3D(base + joint,2.0f*joint,-joint);
+        hand.orientations[joint] = Point3D(0.0f,0.0f,0.1f*joint);
+    }
+    return hand;
+}
+
+// Check that the Group of a hand holds the joints of makeHand
+static void checkHandGroup(Scheduler* scheduler,const string& groupID,bool right,float base)
+{
+    map<string, Group3D*>::const_iterator git = scheduler->getGroups3D().find(groupID);
+    LG_CHECK(git != scheduler->getGroups3D().end());
+    if(git == scheduler->getGroups3D().end()) return;
+    map<string, HOrientedPoint3D*> elements = git->second->getAll();
+    LG_CHECK(elements.size() == LG_LEAP_JOINT_COUNT);
+    for(int joint = 0;joint < LG_LEAP_JOINT_COUNT;joint++)
+    {
+        map<string, HOrientedPoint3D*>::iterator eit = elements.find(LeapGenerator::getJointType(joint,right));
+        LG_CHECK((eit != elements.end())&&(!eit->second->isEmpty()));
+        if((eit == elements.end())||(eit->second->isEmpty())) continue;
+        OrientedPoint3D* point = eit->second->getLast();
+        LG_CHECK(point->getPosition().getX() == base + joint);
+        LG_CHECK(point->getPosition().getY() == 2.0f*joint);
+        LG_CHECK(point->getPosition().getZ() == -joint);
+        LG_CHECK(point->getOrientation().getZ() == 0.1f*joint);
+        LG_CHECK(point->getConfidence() == 0.5f);
+    }
+}
+
+static void testLeapGenerator()
+{
+    // Two hands, then the right hand moving alone (the Group of the left hand is removed), then synthetic hands
+    MockLeapSource* source = new MockLeapSource(1);
+    vector<LeapHandSample> hands;
+    hands.push_back(makeHand(7,true,100.0f));
+    hands.push_back(makeHand(9,false,-100.0f));
+    source->pushFrame(hands);
+    hands.pop_back();
+    hands[0] = makeHand(7,true,110.0f);
+    source->pushFrame(hands);
+
+    Environment* environment = new Environment();
+    Scheduler* scheduler = new Scheduler(environment);
+    LeapGenerator* generator = new LeapGenerator("leap",source);
+    LG_CHECK(LeapGenerator::getJointType(LG_LEAP_JOINT_PALM,true) == LG_ORIENTEDPOINT3D_RIGHT_HAND);
+    LG_CHECK(LeapGenerator::getJointType(LG_LEAP_JOINT_PALM,false) == LG_ORIENTEDPOINT3D_LEFT_HAND);
+    LG_CHECK(scheduler->registerNode(generator));
+    LG_CHECK(scheduler->start());
+
+    LG_CHECK(scheduler->update());
+    LG_CHECK(generator->getLastFrame() == 1);
+    LG_CHECK(scheduler->getGroups3D().size() == 2);
+    checkHandGroup(scheduler,"LEAP_HAND_7",true,100.0f);
+    checkHandGroup(scheduler,"LEAP_HAND_9",false,-100.0f);
+
+    LG_CHECK(scheduler->update());
+    LG_CHECK(generator->getLastFrame() == 2);
+    LG_CHECK(scheduler->getGroups3D().size() == 1);
+    checkHandGroup(scheduler,"LEAP_HAND_7",true,110.0f);
+
+    // The synthetic right hand has the id 1
+    LG_CHECK(scheduler->update());
+    LG_CHECK(generator->getLastFrame() == 3);
+    LG_CHECK(scheduler->getGroups3D().size() == 1);
+    LG_CHECK(scheduler->getGroups3D().count("LEAP_HAND_1") == 1);
+
+    scheduler->stop();
+    delete scheduler;
+    delete environment;
+    delete generator;
+}
+
+#if defined _WIN32  || defined _WIN64
+static void testUdpStreamer(int) {}
+#else
+static uint32_t readUint32(const unsigned char* data)
+{
+    return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | (uint32_t)data[3];
+}
+
+static float readFloat(const unsigned char* data)
+{
+    uint32_t bits = readUint32(data);
+    float value;
+    memcpy(&value,&bits,sizeof(value));
+    return value;
+}
+
+// Check the timestamp and the values of the head of the Group A or B, after the given update of the HeadGenerator (B only moves at the third)
+static void checkHeadValues(const string& groupID,const unsigned char* data,int count)
+{
+    bool b = (groupID == "B");
+    LG_CHECK(b || (groupID == "A"));
+    if(b) count = 3;
+    LG_CHECK((int)readUint32(data) == 10*count);
+    LG_CHECK(readFloat(data + 4) == (float)count);
+    LG_CHECK(readFloat(data + 8) == (b ? 6.0f : 0.0f));
+    LG_CHECK(readFloat(data + 12) == 0.0f);
+    LG_CHECK(readFloat(data + 28) == 1.0f);
+    LG_CHECK(readFloat(data + 32) == 1.0f);
+}
+
+// Decode the records of a binary datagram, return the number of records
+static int checkBinaryDatagram(const unsigned char* data,size_t length,uint32_t frame)
+{
+    LG_CHECK(length >= 16);
+    if(length < 16) return 0;
+    LG_CHECK(readUint32(data) == LG_STREAM_MAGIC);
+    LG_CHECK(readUint32(data + 4) == frame);
+    LG_CHECK((data[12] == 0)&&(data[13] == 0)&&(data[14] == 0)&&(data[15] == 1));
+    int records = 0;
+    size_t offset = 16;
+    while(offset + 4 <= length)
+    {
+        const unsigned char* record = data + offset;
+        LG_CHECK(record[0] == 3);
+        size_t names = (4 + record[1] + record[2] + 3) / 4 * 4;
+        LG_CHECK(offset + names + 36 <= length);
+        if(offset + names + 36 > length) return records;
+        string groupID((const char*)record + 4,record[1]);
+        string type((const char*)record + 4 + record[1],record[2]);
+        LG_CHECK(type == LG_ORIENTEDPOINT3D_HEAD);
+        checkHeadValues(groupID,record + names,(int)frame + 1);
+        offset += names + 36;
+        records++;
+    }
+    LG_CHECK(offset == length);
+    return records;
+}
+
+// Decode the messages of an OSC bundle, return the number of messages
+static int checkOscDatagram(const unsigned char* data,size_t length,int count)
+{
+    LG_CHECK(length >= 16);
+    if(length < 16) return 0;
+    LG_CHECK(memcmp(data,"#bundle\0",8) == 0);
+    LG_CHECK((readUint32(data + 8) == 0)&&(readUint32(data + 12) == 1));
+    int messages = 0;
+    size_t offset = 16;
+    while(offset + 4 <= length)
+    {
+        size_t size = readUint32(data + offset);
+        LG_CHECK(offset + 4 + size <= length);
+        if(offset + 4 + size > length) return messages;
+        const char* message = (const char*)data + offset + 4;
+        string address(message,strnlen(message,size));
+        size_t tags = (address.size() + 4) / 4 * 4;
+        LG_CHECK(strcmp(message + tags,",iffffffff") == 0);
+        size_t values = tags + 12;
+        LG_CHECK(size == values + 36);
+        string prefix = "/lg/";
+        string suffix = string("/") + LG_ORIENTEDPOINT3D_HEAD;
+        LG_CHECK(address.compare(0,prefix.size(),prefix) == 0);
+        LG_CHECK((address.size() > prefix.size() + suffix.size())&&(address.compare(address.size() - suffix.size(),suffix.size(),suffix) == 0));
+        if(size == values + 36) checkHeadValues(address.substr(prefix.size(),address.size() - prefix.size() - suffix.size()),(const unsigned char*)message + values,count);
+        offset += 4 + size;
+        messages++;
+    }
+    LG_CHECK(offset == length);
+    return messages;
+}
+
+static void testUdpStreamer(int format)
+{
+    // Endpoint on the loopback, on a port chosen by the system
+    int endpoint = socket(AF_INET,SOCK_DGRAM,0);
+    LG_CHECK(endpoint >= 0);
+    if(endpoint < 0) return;
+    struct sockaddr_in address;
+    memset(&address,0,sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t addressLength = sizeof(address);
+    struct timeval timeout = {1,0};
+    bool bound = (bind(endpoint,(struct sockaddr*)&address,sizeof(address)) == 0)&&(getsockname(endpoint,(struct sockaddr*)&address,&addressLength) == 0);
+    LG_CHECK(bound);
+    LG_CHECK(setsockopt(endpoint,SOL_SOCKET,SO_RCVTIMEO,&timeout,sizeof(timeout)) == 0);
+    if(!bound)
+    {
+        close(endpoint);
+        return;
+    }
+
+    Environment* environment = new Environment();
+    Scheduler* scheduler = new Scheduler(environment);
+    HeadGenerator* generator = new HeadGenerator();
+    UdpStreamer* streamer = new UdpStreamer("streamer","127.0.0.1",ntohs(address.sin_port),format);
+    LG_CHECK(scheduler->registerNode(generator));
+    LG_CHECK(scheduler->registerNode(streamer));
+    LG_CHECK(scheduler->start());
+    for(int i = 0;i < 3;i++) LG_CHECK(scheduler->update());
+    LG_CHECK(streamer->getSentDatagrams() == 3);
+    LG_CHECK(streamer->getDroppedDatagrams() == 0);
+    LG_CHECK(streamer->getDroppedValues() == 0);
+
+    // One datagram by update : A alone, A alone, then A and B
+    unsigned char data[1472];
+    int expected[3] = {1,1,2};
+    for(uint32_t frame = 0;frame < 3;frame++)
+    {
+        ssize_t length = recv(endpoint,data,sizeof(data),0);
+        LG_CHECK(length > 0);
+        if(length <= 0) break;
+        int records = (format == LG_STREAM_BINARY) ? checkBinaryDatagram(data,(size_t)length,frame) : checkOscDatagram(data,(size_t)length,(int)frame + 1);
+        LG_CHECK(records == expected[frame]);
+    }
+
+    scheduler->stop();
+    close(endpoint);
+    delete scheduler;
+    delete environment;
+    delete streamer;
+    delete generator;
+}
+#endif
+
+int main(int /*argc*/,char* /*argv*/[])
+{
+    testCompatibilityGraph();
+    testGroupSlotMap();
+    testHistoricStatistics();
+    testHistoricWindow();
+    testFilterRetention();
+    testSharedState();
+    testLeapGenerator();
+    testUdpStreamer(LG_STREAM_BINARY);
+    testUdpStreamer(LG_STREAM_OSC);
+
+    if(failures > 0)
+    {
+        printf("%d checks failed\n",failures);
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
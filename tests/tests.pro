@@ -0,0 +1,25 @@
+# Checks of the Scheduler and its helpers : qmake && make && ./tests (returns 0 when all the checks pass)
+TEMPLATE = app
+CONFIG += console c++11
+CONFIG -= app_bundle
+CONFIG -= qt
+
+SOURCES += tests.cpp \
+    ../src/LgCompatibilityGraph.cpp \
+    ../src/LgFilters.cpp \
+    ../src/LgLeapGenerator.cpp \
+    ../src/LgNodeFactory.cpp \
+    ../src/LgScheduler.cpp \
+    ../src/LgSharedStatePublisher.cpp \
+    ../src/LgStatistics.cpp \
+    ../src/LgThreadPool.cpp \
+    ../src/LgUdpStreamer.cpp
+
+win32:CONFIG(release, debug|release): LIBS += -L$$PWD/../lib/ -lGinaWin32
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$PWD/../lib/ -lGinaWin32
+else:unix: LIBS += -L$$PWD/../lib/ -lGinaUnix
+
+unix: LIBS += -lpthread -ldl -lrt
+
+INCLUDEPATH += $$PWD/../include
+DEPENDPATH += $$PWD/../include